@@ -32,16 +32,9 @@ minMaxAI::~minMaxAI()
 //-----------------------------------------------------------------------------
 void minMaxAI::play(const fieldStruct& theField, moveInfo& move)
 {
-	// globals
-	for (auto& vars : threadVars) {
-		vars.field			= theField;
-		vars.curSearchDepth	= 0;
-		vars.currentValue	= 0;
-		vars.oldStates.clear();
-	}
+	// locals
 	unsigned int		bestChoice;
 	unsigned int		searchDepth;
-	miniMax::stateInfo 	infoAboutChoices;
 
 	// automatic depth
 	if (depthOfFullTree == 0) {
@@ -53,8 +46,40 @@ void minMaxAI::play(const fieldStruct& theField, moveInfo& move)
 		searchDepth = depthOfFullTree;
 	}
 
-	// reserve memory
+	// start the miniMax-algorithmn
+	searchBestChoice(theField, searchDepth, bestChoice);
+
+	// decode the best choice - convert possibility ID to moveInfo with integrated stone removal
+	move.setId(bestChoice);
+
+	// when the stone removal is a separate ply, the stone to remove is chosen by a second search after closing the mill
+	if (removalMode == stoneRemoval::separatePly) {
+		fieldStruct 				fieldAfterMove	= theField;
+		fieldStruct::backupStruct	backup;
+		fieldAfterMove.setStoneRemoval(removalMode);
+		if (fieldAfterMove.move(move, backup) && fieldAfterMove.isRemovalPending()) {
+			searchBestChoice(fieldAfterMove, searchDepth, bestChoice);
+			move.removeStone = moveInfo::getMoveInfo(bestChoice).removeStone;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: searchBestChoice()
+// Desc: Runs the miniMax algorithm on the passed field and returns the id of the best possibility.
+//-----------------------------------------------------------------------------
+void minMaxAI::searchBestChoice(const fieldStruct& theField, unsigned int searchDepth, unsigned int& bestChoice)
+{
+	// locals
+	miniMax::stateInfo 	infoAboutChoices;
+
+	// reset the thread variables and reserve memory
 	for (auto& vars : threadVars) {
+		vars.field			= theField;
+		vars.field.setStoneRemoval(removalMode);
+		vars.curSearchDepth	= 0;
+		vars.currentValue	= 0;
+		vars.oldStates.clear();
 		vars.oldStates.resize(searchDepth + 3);
 	}
 
@@ -63,9 +88,6 @@ void minMaxAI::play(const fieldStruct& theField, moveInfo& move)
 	if (!mm.getBestChoice(bestChoice, infoAboutChoices)) {
 		throw std::runtime_error("Error in minMaxAI::play() - getBestChoice() failed.");
 	}
-
-	// decode the best choice - convert possibility ID to moveInfo with integrated stone removal
-	move.setId(bestChoice);
 }
 
 //-----------------------------------------------------------------------------
@@ -77,6 +99,16 @@ void minMaxAI::setSearchDepth(unsigned int depth)
 	depthOfFullTree = depth;
 }
 
+//-----------------------------------------------------------------------------
+// Name: setStoneRemoval()
+// Desc: If stoneRemoval::separatePly is passed, closing a mill and removing a stone are searched as two plies of the same player.
+//       Thus the removals are ordered and pruned independently of the move closing the mill.
+//-----------------------------------------------------------------------------
+void minMaxAI::setStoneRemoval(stoneRemoval mode)
+{
+	removalMode = mode;
+}
+
 //-----------------------------------------------------------------------------
 // Name: prepareBestChoiceCalculation()
 // Desc: 
@@ -95,7 +127,12 @@ void minMaxAI::prepareCalculation()
 //-----------------------------------------------------------------------------
 void minMaxAI::getPossibilities(unsigned int threadNo, vector<unsigned int>& possibilityIds)
 {
-	threadVars[threadNo].field.getPossibilities(possibilityIds);
+	// locals
+	threadVarsStruct&	vars				= threadVars[threadNo];
+	unsigned int		numPossibilities	= vars.field.getPossibilities(vars.possibilities);
+
+	// the vector of the miniMax library keeps its capacity, so no memory is allocated once it has grown
+	possibilityIds.assign(vars.possibilities.begin(), vars.possibilities.begin() + numPossibilities);
 }
 
 //-----------------------------------------------------------------------------
@@ -127,7 +164,7 @@ void minMaxAI::getValueOfSituation(unsigned int threadNo, float &floatValue, min
 //-----------------------------------------------------------------------------
 unsigned int minMaxAI::getMaxNumPossibilities()
 {
-	return fieldStruct::maxNumPosMoves;
+	return (removalMode == stoneRemoval::separatePly) ? fieldStruct::maxNumPosMovesSeparateRemoval : fieldStruct::maxNumPosMoves;
 }
 
 //-----------------------------------------------------------------------------
@@ -146,7 +183,7 @@ void minMaxAI::move(unsigned int threadNo, unsigned int idPossibility, bool& pla
 	moveInfo 					moveToMake;
 
 	// convert possibility ID to moveInfo
-	moveToMake.setId(idPossibility);
+	moveToMake = moveInfo::getMoveInfo(idPossibility);
 
 	// backup
 	oldStateMm.value 	= currentValue;
@@ -157,8 +194,8 @@ void minMaxAI::move(unsigned int threadNo, unsigned int idPossibility, bool& pla
 		throw std::runtime_error("Invalid move detected during minMaxAI::move execution.");
 	};
 
-	// player changes after every move
-	playerToMoveChanged = true;
+	// player changes after every move, except after closing a mill when the stone removal is a separate ply
+	playerToMoveChanged = !field.isRemovalPending();
 }
 
 //-----------------------------------------------------------------------------
@@ -181,13 +218,13 @@ void minMaxAI::undo(unsigned int threadNo, unsigned int idPossibility, bool& pla
 	currentValue = oldStateMm.value;
 	curSearchDepth--;
 
+	// player changes back, unless the undone move closed a mill and left the stone removal pending
+	playerToMoveChanged = !field.isRemovalPending();
+
 	fieldStruct::backupStruct& oldStateFs = oldStateMm;
 	if (!field.undo(oldStateFs)) {
 		throw std::runtime_error("Invalid undo detected during minMaxAI::undo execution.");
 	}
-
-	// player always changes back after undo
-	playerToMoveChanged = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -200,8 +237,9 @@ void minMaxAI::printMoveInformation(unsigned int threadNo, unsigned int idPossib
 	moveInfo move;
 	move.setId(idPossibility);
 
-	// move
-	if (threadVars[threadNo].field.inSettingPhase())	cout << "set stone to "      << (char) (move.to + 97) << endl;															
+	// move, which is missing if the stone removal is a separate ply
+	if (move.to >= fieldStruct::size)					{}
+	else if (threadVars[threadNo].field.inSettingPhase())	cout << "set stone to "      << (char) (move.to + 97) << endl;															
 	else												cout << "move from "		 << (char) (move.from + 97) << " to " << (char) (move.to + 97) << endl;
 	if (move.removeStone < fieldStruct::size)			cout << "remove stone from " << (char) (move.removeStone + 97) << endl;														
 }
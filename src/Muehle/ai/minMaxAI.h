@@ -46,7 +46,6 @@ protected:
 	struct backupStruct : public fieldStruct::backupStruct
 	{
 		float			value;
-		warningArray	warnings;
 	};
 
 	struct threadVarsStruct
@@ -55,16 +54,19 @@ protected:
 		float						currentValue		= 0;					// value of current situation for field->currentPlayer
 		unsigned int				curSearchDepth		= 0;					// current level
 		std::vector<backupStruct>	oldStates;									// for undo()-function	
+		fieldStruct::possibilityArray possibilities;							// buffer for getPossibilities(), avoiding any allocation
 	};
 
 	// Variables
 	// 'mm' is the minimax algorithm instance; 'this' passes the current AI as the game interface, and '100' sets the maximum search depth (chosen as a safe upper bound for practical search limits).
 	miniMax::miniMax				mm					{this, 100};			// minimax algorithmn
 	unsigned int					depthOfFullTree		= 0;					// search depth where the whole tree is explored
+	stoneRemoval					removalMode			= stoneRemoval::withinMove;	// if separatePly, closing a mill and removing a stone are searched as two plies
 	std::vector<threadVarsStruct>	threadVars;									// information for each thread
 
 	// init
 	void				prepareCalculation				()																													override;	
+	void				searchBestChoice				(const fieldStruct& theField, unsigned int searchDepth, unsigned int& bestChoice);
 
 	// getter
 	void				getPossibilities				(unsigned int threadNo, std::vector<unsigned int>& possibilityIds)													override;	
@@ -88,6 +90,7 @@ public:
 	// Functions
 	void				play							(const fieldStruct& theField, moveInfo& move) override;
 	void				setSearchDepth					(unsigned int depth);
+	void				setStoneRemoval					(stoneRemoval mode);
 };
 
 #endif
\ No newline at end of file
@@ -9,11 +9,11 @@
 
 //-----------------------------------------------------------------------------
 // Name: perfectAI()
-// Desc: perfectAI class constructor
+// Desc: perfectAI class constructor. With stateAddressing::rankingEngine::tableFree the state addressing needs only a few MB.
 //-----------------------------------------------------------------------------
-perfectAI::perfectAI(wstring const& directory) :
+perfectAI::perfectAI(wstring const& directory, stateAddressing::rankingEngine engine) :
 	databaseDirectory(calcDatabaseDirectory(directory)),
-	sa(databaseDirectory)
+	sa(databaseDirectory, engine)
 {
 	// thread specific variables
 	threadVars.resize(mm.getNumThreads(), threadVarsStruct(sa));
@@ -182,11 +182,16 @@ bool perfectAI::shallRetroAnalysisBeUsed(unsigned int layerNum)
 
 //-----------------------------------------------------------------------------
 // Name: getNumberOfKnotsInLayer()
-// Desc: called one time
+// Desc: called one time. Returns 0, if the layer exceeds the range of the miniMax library.
 //-----------------------------------------------------------------------------
 unsigned int perfectAI::getNumberOfKnotsInLayer(unsigned int layerNum)
 {
-    return sa.getNumberOfKnotsInLayer(layerNum);
+	unsigned int numberOfKnots;
+	if (!threadVarsStruct::toMiniMaxStateNumber(sa.getNumberOfKnotsInLayer(layerNum), numberOfKnots)) {
+		cout << "\nERROR: Number of knots in layer " << layerNum << " exceeds the range of the miniMax library.\n";
+		return 0;
+	}
+	return numberOfKnots;
 }
 
 //-----------------------------------------------------------------------------
@@ -211,12 +216,17 @@ unsigned int perfectAI::getLayerNumber(unsigned int threadNo)
 
 //-----------------------------------------------------------------------------
 // Name: getLayerAndStateNumber()
-// Desc: 
+// Desc: Returns an invalid layer number, if the state number exceeds the range of the miniMax library.
 //-----------------------------------------------------------------------------
 void perfectAI::getLayerAndStateNumber(unsigned int threadNo, unsigned int& layerNum, unsigned int& stateNumber, unsigned int& symOp)
 {
 	if (threadNo >= mm.getNumThreads()) { layerNum = getNumberOfLayers(); stateNumber = 0; symOp = 0; return; }
-	threadVars[threadNo].getLayerAndStateNumber(layerNum, stateNumber, symOp);
+	stateAddressing::stateId stateNumberOfThread;
+	threadVars[threadNo].getLayerAndStateNumber(layerNum, stateNumberOfThread, symOp);
+	if (!threadVarsStruct::toMiniMaxStateNumber(stateNumberOfThread, stateNumber)) {
+		cout << "\nERROR: State number exceeds the range of the miniMax library.\n";
+		layerNum = getNumberOfLayers(); stateNumber = 0; symOp = 0;
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -229,7 +239,7 @@ bool perfectAI::setSituation(unsigned int threadNo, unsigned int layerNum, unsig
 	// parameters ok ?
 	if (threadNo				   >= mm.getNumThreads()) return false;
 	if (getNumberOfLayers()				  <= layerNum   ) return false;
-	if (getNumberOfKnotsInLayer(layerNum) <= stateNumber) return false;
+	if (sa.getNumberOfKnotsInLayer(layerNum) <= stateNumber) return false;
 	return threadVars[threadNo].setSituation(layerNum, stateNumber);
 }
 
@@ -273,7 +283,7 @@ void perfectAI::getField(unsigned int layerNum, unsigned int stateNumber, unsign
 // Name: getLayerAndStateNumber()
 // Desc: 
 //-----------------------------------------------------------------------------
-void perfectAI::getLayerAndStateNumber(unsigned int& layerNum, unsigned int& stateNumber)
+void perfectAI::getLayerAndStateNumber(unsigned int& layerNum, stateAddressing::stateId& stateNumber)
 {
 	unsigned int symOp;
 	threadVars[0].getLayerAndStateNumber(layerNum, stateNumber, symOp);
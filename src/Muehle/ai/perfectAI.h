@@ -65,13 +65,13 @@ public:
 	wstring						getOutputInformation			(unsigned int layerNum)																								override;
 
     // Constructor / destructor
-								perfectAI						(wstring const& directory);
+								perfectAI						(wstring const& directory, stateAddressing::rankingEngine engine = stateAddressing::rankingEngine::lookupTables);
 								~perfectAI						();
 
 	// Functions for using the AI with calculated database
 	void						play							(const fieldStruct& theField, moveInfo& move) 																		override;
 	void						getField						(unsigned int  layerNum, unsigned int  stateNumber, unsigned char symOp, fieldStruct &field, bool &gameHasFinished);
-	void						getLayerAndStateNumber			(unsigned int& layerNum, unsigned int& stateNumber);
+	void						getLayerAndStateNumber			(unsigned int& layerNum, stateAddressing::stateId& stateNumber);
 	const miniMax::stateInfo&	getInfoAboutChoices				() const;
 };
 
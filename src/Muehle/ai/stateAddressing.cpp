@@ -7,6 +7,15 @@
 
 #include "stateAddressing.h"
 #include <cassert>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
 #ifdef _MSC_VER
 	#include <limits>
 	#undef max
@@ -21,18 +30,16 @@ using namespace std;
 // Desc: Initializes the state addressing. Thereby the precalculated variables are loaded from the file preCalculatedVars.dat.
 //		 If the file does not exist, the precalculated variables are calculated and saved into the file.
 // Args: directory - the directory where the preCalculatedVars.dat file is stored
+//		 engine    - with rankingEngine::tableFree the large tables groupIndexCD and symmetryOperationCD are neither mapped nor kept in memory
 //-----------------------------------------------------------------------------
-stateAddressing::stateAddressing(std::wstring const& directory)
+stateAddressing::stateAddressing(std::wstring const& directory, rankingEngine engine) :
+	engine{engine}
 {
 	// allocate memory
 	resizeVector2D(amountSituationsCD, 			groupIndex{0}, 			NUM_STONES_PER_PLAYER+1, NUM_STONES_PER_PLAYER+1);
 	resizeVector2D(amountSituationsAB, 			groupIndex{0}, 			NUM_STONES_PER_PLAYER+1, NUM_STONES_PER_PLAYER+1);
 	resizeVector1D(groupIndexAB, 				groupIndex{0}, 			MAX_NUM_SITUATIONS_A * MAX_NUM_SITUATIONS_B);
-	resizeVector1D(groupIndexCD, 				groupIndex{0}, 			MAX_NUM_SITUATIONS_C * MAX_NUM_SITUATIONS_D);
-	resizeVector1D(symmetryOperationCD, 		symOperationId{0}, 		MAX_NUM_SITUATIONS_C * MAX_NUM_SITUATIONS_D);
 	resizeVector2D(symmetryTransformationTable, 0u, 					NUM_SYM_OPERATIONS, fieldStruct::size);
-	resizeVector3D(groupStateCD, 				groupStateNumber{0}, 	NUM_STONES_PER_PLAYER+1, NUM_STONES_PER_PLAYER+1, 1);
-	resizeVector3D(groupStateAB, 				groupStateNumber{0}, 	NUM_STONES_PER_PLAYER+1, NUM_STONES_PER_PLAYER+1, 1);
 	resizeVector1D(powerOfThree, 				0u, 					numSquaresGroupC + numSquaresGroupD);
 	resizeVector2D(mOverN, 						0u, 					fieldStruct::size + 1, fieldStruct::size + 1);
 	resizeVector1D(reverseSymOperation, 		symOperationId{0}, 		NUM_SYM_OPERATIONS);
@@ -43,11 +50,13 @@ stateAddressing::stateAddressing(std::wstring const& directory)
 	// locals
 	cacheFile cf(directory, *this);
 
-	// vars already stored in file?
-	if (cf.readFromFile()) {
-		return;
-	// calculate vars and save into file
-	} else {
+	// calculate vars and save into file, if they are not already stored in it
+	if (!cf.readFromFile()) {
+
+		// a rejected file might have been copied partially
+		amountSituationsCD.assign(NUM_STONES_PER_PLAYER+1, vector1D<groupIndex>(NUM_STONES_PER_PLAYER+1, groupIndex{0}));
+		amountSituationsAB.assign(NUM_STONES_PER_PLAYER+1, vector1D<groupIndex>(NUM_STONES_PER_PLAYER+1, groupIndex{0}));
+		layer.assign(NUM_LAYERS, layerStruct{});
 
 		// calc mOverN
 		init_mOverN();
@@ -76,6 +85,15 @@ stateAddressing::stateAddressing(std::wstring const& directory)
 		// write cache to file
 		cf.writeToFile();
 	}
+
+	// the large tables are only needed for the calculation of the others
+	if (engine == rankingEngine::tableFree) {
+		groupIndexCD.clear();
+		symmetryOperationCD.clear();
+	}
+
+	// init symmetryPermutationTable and symmetricStateOfByteCD, which are not stored in the file
+	init_symmetryPermutationTable();
 }
 
 //-----------------------------------------------------------------------------
@@ -149,6 +167,34 @@ void stateAddressing::init_symOperationMappings()
 	reverseSymOperation[SO_INV_MIR_DIAG_2] = SO_INV_MIR_DIAG_2;  	
 }
 
+//-----------------------------------------------------------------------------
+// Name: init_symmetryPermutationTable()
+// Desc: Splits each symmetry operation into one lookup table per byte of a bit board,
+//       so that the image of a bit board is the bitwise or of numBytesPerBitBoard lookups.
+//       Likewise the symmetric group state number of group C&D is the sum of numBytesPerBitBoard lookups per player.
+//-----------------------------------------------------------------------------
+void stateAddressing::init_symmetryPermutationTable()
+{
+	for (symOperationId symOp = 0; symOp < NUM_SYM_OPERATIONS; symOp++) {
+		for (unsigned int byte = 0; byte < numBytesPerBitBoard; byte++) {
+			for (unsigned int value = 0; value < 256; value++) {
+
+				// the symmetric field takes the stone of square symMap[pos] for square pos
+				bitBoard squares = 0;
+				for (fieldStruct::fieldPos pos = 0; pos < fieldStruct::size; pos++) {
+					const unsigned int srcPos = symmetryTransformationTable[symOp][pos];
+					if (srcPos / 8 == byte && (value >> (srcPos % 8)) & 1) squares |= fieldStruct::squareMask(pos);
+				}
+				symmetryPermutationTable[symOp][byte][value] = squares;
+
+				groupStateNumber state = 0;
+				while (squares) state += squareWeightCD[fieldStruct::popSquare(squares)];
+				symmetricStateOfByteCD[symOp][byte][value] = state;
+			}
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Name: init_concSymOperation()
 // Desc: 
@@ -184,21 +230,26 @@ void stateAddressing::init_concSymOperation()
 }
 
 //-----------------------------------------------------------------------------
-// Name: resizeOriginalState()
-// Desc:
+// Name: resizeGroupStateMappingArray()
+// Desc: Reserves the group states of each number of white and black stones one after another.
 //-----------------------------------------------------------------------------
-void stateAddressing::resizeGroupStateMappingArray(vector3D<unsigned int>& groupState, const vector2D<unsigned int>* pAmountSituations, unsigned int numSquaresInGroup) const
+void stateAddressing::resizeGroupStateMappingArray(groupStateTable& groupState, const vector2D<groupIndex>* pAmountSituations, unsigned int numSquaresInGroup) const
 {
 	// locals
 	numWhiteStones 	nws;
 	numBlackStones 	nbs;
 	groupIndex 		amountSituations;
+	unsigned int	numStates		= 0;
 
+	groupState.offset.assign((NUM_STONES_PER_PLAYER+1) * (NUM_STONES_PER_PLAYER+1) + 1, 0);
 	for (nws=0; nws<=NUM_STONES_PER_PLAYER; nws++) { for (nbs=0; nbs<=NUM_STONES_PER_PLAYER; nbs++) {
+		groupState.offset[nws * (NUM_STONES_PER_PLAYER+1) + nbs] = numStates;
 		if (nws + nbs > numSquaresInGroup) continue;
 		amountSituations = (pAmountSituations != nullptr) ? (*pAmountSituations)[nws][nbs] : mOverN[numSquaresInGroup][nws] * mOverN[numSquaresInGroup - nws][nbs];
-		groupState[nws][nbs].resize(amountSituations);
+		numStates		+= amountSituations;
 	}}
+	groupState.offset.back() = numStates;
+	groupState.state.assign(numStates, groupStateNumber{0});
 }
 
 //-----------------------------------------------------------------------------
@@ -241,7 +292,7 @@ void stateAddressing::init_group_AB()
 
 		// mark original state
 		groupIndexAB[stateAB]						  = amountSituationsAB[nws][nbs];
-		groupStateAB[nws][nbs][groupIndexAB[stateAB]] = stateAB;
+		groupStateAB(nws, nbs, groupIndexAB[stateAB]) = stateAB;
 
 		// state counter
 		amountSituationsAB[nws][nbs]++;    
@@ -250,77 +301,170 @@ void stateAddressing::init_group_AB()
 
 //-----------------------------------------------------------------------------
 // Name: init_group_CD()
-// Desc: 
+// Desc: Assigns a groupIndex to each state of group C&D, being the same for all symmetric states. The state with the lowest groupStateNumber of the symmetric ones is the original state.
+//		 The 3^16 states are processed in parallel, with one chunk per value of the upper 8 digits. The symmetric state numbers are composed of two table lookups per symmetry operation.
+//		 1st pass: determine the original state and the symmetry operation of each state, and count the original states of each chunk.
+//		 2nd pass: number the original states in ascending order, starting at the count of the preceding chunks.
+//		 3rd pass: copy the groupIndex of the original state to the symmetric ones.
 //-----------------------------------------------------------------------------
 void stateAddressing::init_group_CD()
 {
 	// locals
-	unsigned int					i;
-	numWhiteStones 					nws;
-	numBlackStones 					nbs;	
-	groupStateNumber 				stateCD;
-	groupStateNumber				symStateCD;
+	const unsigned int				numChunks		= MAX_NUM_SITUATIONS_C;		// chunk = stateCD / chunkSize
+	const unsigned int				chunkSize		= MAX_NUM_SITUATIONS_D;		// the lower 8 digits
+	const unsigned int				numStoneCounts	= NUM_STONES_PER_PLAYER+1;
+	const unsigned int				stonesBase		= numSquaresGroupC+numSquaresGroupD+1;	// the number of stones is packed as white + stonesBase * black
+	vector1D<groupStateNumber>		symStateLow		(chunkSize * NUM_SYM_OPERATIONS);	// [stateCD % chunkSize][symOp] -> part of the symmetric state number, with the symmetry operations side by side for vectorization
+	vector1D<groupStateNumber>		symStateHigh	(numChunks * NUM_SYM_OPERATIONS);	// [stateCD / chunkSize][symOp] -> ''
+	vector1D<unsigned int>			numStonesLow	(chunkSize);				// [stateCD % chunkSize] -> number of white stones + stonesBase * number of black stones
+	vector1D<unsigned int>			numStonesHigh	(numChunks);				// [stateCD / chunkSize] -> ''
+	vector1D<groupIndex>			chunkOffset		(numChunks * numStoneCounts * numStoneCounts, 0);	// [chunk][nws][nbs] -> number of original states in the chunk, and later in the preceding chunks
+	vector1D<groupStateNumber>		symStateOfDigit	(NUM_SYM_OPERATIONS * (numSquaresGroupC + numSquaresGroupD));
 	fieldStruct::fieldArray 		myField;
 	fieldStruct::fieldArray 		symField;
-	vector3D<groupStateNumber>		originalStateCD_tmp;
-	
-	// reserve memory
-	resizeVector3D(originalStateCD_tmp, groupStateNumber{0}, NUM_STONES_PER_PLAYER+1, NUM_STONES_PER_PLAYER+1, 1);
-	resizeGroupStateMappingArray(originalStateCD_tmp, nullptr, numSquaresGroupC + numSquaresGroupD);
 
 	// mark all indexCD as not indexed
 	groupIndexCD.assign(MAX_NUM_SITUATIONS_C*MAX_NUM_SITUATIONS_D, NOT_INDEXED);
+	symmetryOperationCD.assign(MAX_NUM_SITUATIONS_C*MAX_NUM_SITUATIONS_D, packedSymOperationId{0});
 
-	// iterate through each state within group C&D
-	for (stateCD=0; stateCD<MAX_NUM_SITUATIONS_C*MAX_NUM_SITUATIONS_D; stateCD++) {
-
-		// new state ?
-		if (groupIndexCD[stateCD] != NOT_INDEXED) continue;
-
-		// zero field
-		myField.fill(playerId::squareIsFree);
-
-		// make field
-		calcFieldBasedOnGroupCD(myField, stateCD);
+	// a symmetry operation only permutes the squares within group C&D, so the symmetric state number is the sum of the symmetric state numbers of each digit
+	for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+		for (unsigned int digit=0; digit<numSquaresGroupC+numSquaresGroupD; digit++) {
+			myField.fill(playerId::squareIsFree);
+			calcFieldBasedOnGroupCD(myField, powerOfThree[digit]);
+			applySymmetryTransfToField(symOp, false, myField, symField);
+			calcGroupStateNumberCD(symField, symStateOfDigit[symOp * (numSquaresGroupC + numSquaresGroupD) + digit]);
+		}
+	}
+	auto calcSymState = [&](symOperationId symOp, groupStateNumber state, unsigned int firstDigit) {
+		groupStateNumber symState = 0;
+		for (unsigned int digit=firstDigit; state; digit++, state /= 3) {
+			symState += (state % 3) * symStateOfDigit[symOp * (numSquaresGroupC + numSquaresGroupD) + digit];
+		}
+		return symState;
+	};
+	auto countStones = [&](groupStateNumber state) {
+		unsigned int stones = 0;
+		for (; state; state /= 3) {
+			if (static_cast<playerId>(state % 3) == fieldStruct::playerWhite) stones += 1;
+			if (static_cast<playerId>(state % 3) == fieldStruct::playerBlack) stones += stonesBase;
+		}
+		return stones;
+	};
+	for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+		for (groupStateNumber low =0; low <chunkSize; low++ ) symStateLow [low  * NUM_SYM_OPERATIONS + symOp] = calcSymState(symOp, low,  0);
+		for (groupStateNumber high=0; high<numChunks; high++) symStateHigh[high * NUM_SYM_OPERATIONS + symOp] = calcSymState(symOp, high, numSquaresGroupD);
+	}
+	for (groupStateNumber low =0; low <chunkSize; low++ ) numStonesLow [low ] = countStones(low );
+	for (groupStateNumber high=0; high<numChunks; high++) numStonesHigh[high] = countStones(high);
 
-		// count black and white stones
-		for (nws=0,i=0; i<fieldStruct::size; i++) if (myField[i] == fieldStruct::playerWhite) nws++; 
-		for (nbs=0,i=0; i<fieldStruct::size; i++) if (myField[i] == fieldStruct::playerBlack) nbs++; 
+	// 1st pass: groupIndexCD temporarily holds the state number of the original state
+	runInParallel(numChunks, [&](unsigned int chunk) {
 		
-		// condition
-		if (nws + nbs > numSquaresGroupC + numSquaresGroupD) continue;
-		if (nws	  > NUM_STONES_PER_PLAYER) continue;
-		if (nbs	  > NUM_STONES_PER_PLAYER) continue;
+		// locals
+		array<groupStateNumber, NUM_SYM_OPERATIONS> 		symStateCD;
+		const groupStateNumber*								symStateOfChunk		= &symStateHigh[chunk * NUM_SYM_OPERATIONS];
+		array<symOperationId, NUM_SYM_OPERATIONS>			reverseSymOp;
 
-		// mark original state
-		groupIndexCD        [stateCD]                        	= amountSituationsCD[nws][nbs];
-		symmetryOperationCD [stateCD]                        	= SO_DO_NOTHING;
-		originalStateCD_tmp [nws][nbs][groupIndexCD[stateCD]] 	= stateCD;
+		copy(reverseSymOperation.begin(), reverseSymOperation.end(), reverseSymOp.begin());
 
-		// mark all symmetric states
-		for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+		for (groupStateNumber low=0; low<chunkSize; low++) {
 			
-			applySymmetryTransfToField(symOp, false, myField, symField);
+			// condition
+			const groupStateNumber	stateCD	= chunk * chunkSize + low;
+			const unsigned int		stones	= numStonesLow[low] + numStonesHigh[chunk];
+			const numWhiteStones	nws		= stones % stonesBase;
+			const numBlackStones	nbs		= stones / stonesBase;
+			if (nws >= numStoneCounts) continue;
+			if (nbs >= numStoneCounts) continue;
+
+			// the original state is the symmetric state with the lowest number
+			const groupStateNumber*	symStateOfLow 	= &symStateLow[low * NUM_SYM_OPERATIONS];
+			groupStateNumber 		originalStateCD = stateCD;
+			for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+				symStateCD[symOp] = symStateOfLow[symOp] + symStateOfChunk[symOp];
+			}
+			for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+				originalStateCD = (symStateCD[symOp] < originalStateCD) ? symStateCD[symOp] : originalStateCD;
+			}
+			groupIndexCD[stateCD] = originalStateCD;
+
+			if (originalStateCD == stateCD) {
+				symmetryOperationCD[stateCD] = SO_DO_NOTHING;
+				chunkOffset[(chunk * numStoneCounts + nws) * numStoneCounts + nbs]++;
+			} else {
+				// the original state is turned into this one by the inverse of each symmetry operation turning this state into the original one. the highest of them is taken.
+				symOperationId highestSymOp = 0;
+				for (symOperationId symOp=0; symOp<NUM_SYM_OPERATIONS; symOp++) {
+					if (symStateCD[symOp] != originalStateCD) continue;
+					if (reverseSymOp[symOp] >= highestSymOp) highestSymOp = reverseSymOp[symOp];
+				}
+				symmetryOperationCD[stateCD] = reverseSymOp[highestSymOp];
+			}
+		}
+	});
+
+	// offset of each chunk, being the number of original states in the preceding chunks
+	for (numWhiteStones nws=0; nws<numStoneCounts; nws++) { for (numBlackStones nbs=0; nbs<numStoneCounts; nbs++) {
+		amountSituationsCD[nws][nbs] = 0;
+		for (unsigned int chunk=0; chunk<numChunks; chunk++) {
+			groupIndex& offset 				 = chunkOffset[(chunk * numStoneCounts + nws) * numStoneCounts + nbs];
+			groupIndex	numOriginalStates	 = offset;
+			offset							 = amountSituationsCD[nws][nbs];
+			amountSituationsCD[nws][nbs]	+= numOriginalStates;
+		}
+	}}
+	resizeGroupStateMappingArray(groupStateCD, &amountSituationsCD, numSquaresGroupC + numSquaresGroupD);
 
-			calcGroupStateNumberCD(symField, symStateCD);
+	// 2nd pass: number the original states
+	runInParallel(numChunks, [&](unsigned int chunk) {
+		for (groupStateNumber low=0; low<chunkSize; low++) {
+			const groupStateNumber stateCD = chunk * chunkSize + low;
+			if (groupIndexCD[stateCD] != stateCD) continue;
+			const unsigned int		stones	= numStonesLow[low] + numStonesHigh[chunk];
+			const numWhiteStones	nws		= stones % stonesBase;
+			const numBlackStones	nbs		= stones / stonesBase;
+			groupIndexCD[stateCD] 						= chunkOffset[(chunk * numStoneCounts + nws) * numStoneCounts + nbs]++;
+			groupStateCD(nws, nbs, groupIndexCD[stateCD]) 	= stateCD;
+		}
+	});
+
+	// 3rd pass: the original states are the only ones with SO_DO_NOTHING, since no other symmetry operation leaves them unchanged while turning them into another state
+	runInParallel(numChunks, [&](unsigned int chunk) {
+		for (groupStateNumber stateCD=chunk*chunkSize; stateCD<(chunk+1)*chunkSize; stateCD++) {
+			if (groupIndexCD[stateCD] == NOT_INDEXED) continue;
+			if (symmetryOperationCD[stateCD] == SO_DO_NOTHING) continue;
+			groupIndexCD[stateCD] = groupIndexCD[groupIndexCD[stateCD]];
+		}
+	});
+}
+
+//-----------------------------------------------------------------------------
+// Name: runInParallel()
+// Desc: Calls processChunk for each chunk from 0 to numChunks-1, distributed over all hardware threads. The chunks must be independent of each other.
+//-----------------------------------------------------------------------------
+void stateAddressing::runInParallel(unsigned int numChunks, const std::function<void(unsigned int)>& processChunk)
+{
+	// locals
+	unsigned int				numThreads	= thread::hardware_concurrency();
+	atomic<unsigned int>		nextChunk	= 0;
+	vector<thread>				threads;
 
+	// the number of hardware threads might not be known
+	if (numThreads == 0) numThreads = 1;
 
-			if (stateCD != symStateCD) {
-				groupIndexCD        [symStateCD] = groupIndexCD[stateCD];
-				symmetryOperationCD [symStateCD] = reverseSymOperation[symOp];
-			}
+	auto worker = [&]() {
+		for (unsigned int chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+			processChunk(chunk);
 		}
-
-		// state counter
-		amountSituationsCD[nws][nbs]++;    
+	};
+	for (unsigned int threadNo = 1; threadNo < numThreads; threadNo++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& curThread : threads) {
+		curThread.join();
 	}
-
-	// copy from originalStateCD_tmp to originalStateCD
-	resizeGroupStateMappingArray(groupStateCD, &amountSituationsCD, numSquaresGroupC + numSquaresGroupD);
-	for (nws=0; nws<=NUM_STONES_PER_PLAYER; nws++) { for (nbs=0; nbs<=NUM_STONES_PER_PLAYER; nbs++) {
-		if (nws + nbs > numSquaresGroupC + numSquaresGroupD) continue;
-		for (i=0; i<amountSituationsCD[nws][nbs]; i++) groupStateCD[nws][nbs][i] = originalStateCD_tmp[nws][nbs][i];
-	}}
 }
 
 //-----------------------------------------------------------------------------
@@ -356,7 +500,7 @@ void stateAddressing::initLayerRegardingMovingPhase()
 
 			// iterate through each number of white and black stones for group C&D
 			subLayerId curSubLayerId 		= 0;
-			groupIndex curGroupIndexOffset 	= 0;
+			stateId curGroupIndexOffset 	= 0;
 			for (wCD=0; wCD<=layer[layerNum].amountWhiteStones; wCD++) { for (bCD=0; bCD<=layer[layerNum].amountBlackStones; bCD++) {
 
 				// calc number of white and black stones for group A&B
@@ -370,7 +514,7 @@ void stateAddressing::initLayerRegardingMovingPhase()
 				if (wCD + bCD > numSquaresGroupC + numSquaresGroupD)  continue;
 
 				layer[layerNum].subLayer[curSubLayerId].minIndex           		= curGroupIndexOffset;
-				layer[layerNum].subLayer[curSubLayerId].maxIndex           		= curGroupIndexOffset + amountSituationsAB[wAB][bAB] * amountSituationsCD[wCD][bCD] - 1;
+				layer[layerNum].subLayer[curSubLayerId].maxIndex           		= curGroupIndexOffset + static_cast<stateId>(amountSituationsAB[wAB][bAB]) * amountSituationsCD[wCD][bCD] - 1;
 				layer[layerNum].subLayer[curSubLayerId].numBlackStonesGroupAB  	= bAB;
 				layer[layerNum].subLayer[curSubLayerId].numBlackStonesGroupCD  	= bCD;
 				layer[layerNum].subLayer[curSubLayerId].numWhiteStonesGroupAB  	= wAB;
@@ -378,7 +522,7 @@ void stateAddressing::initLayerRegardingMovingPhase()
 				layer[layerNum].subLayerIndexAB[wAB][bAB]                      	= NOT_INDEXED;
 				layer[layerNum].subLayerIndexCD[wCD][bCD]                      	= curSubLayerId;
 				layer[layerNum].numSubLayers++;
-				curGroupIndexOffset += amountSituationsAB[wAB][bAB] * amountSituationsCD[wCD][bCD];
+				curGroupIndexOffset += static_cast<stateId>(amountSituationsAB[wAB][bAB]) * amountSituationsCD[wCD][bCD];
 				curSubLayerId++;
 			}}
 
@@ -421,7 +565,7 @@ void stateAddressing::initLayerRegardingSettingPhase()
 			
 			// iterate through each number of white and black stones for group C&D
 			subLayerId curSubLayerId 		= 0;
-			groupIndex curGroupIndexOffset 	= 0;			
+			stateId curGroupIndexOffset 	= 0;			
 			for (wCD=0; wCD<=layer[layerNum].amountWhiteStones; wCD++) { for (bCD=0; bCD<=layer[layerNum].amountBlackStones; bCD++) {
 
 				// calc number of white and black stones for group A&B
@@ -435,7 +579,7 @@ void stateAddressing::initLayerRegardingSettingPhase()
 				if (wCD + bCD > numSquaresGroupC + numSquaresGroupD)  continue;
 
 				layer[layerNum].subLayer[curSubLayerId].minIndex           		= curGroupIndexOffset;
-				layer[layerNum].subLayer[curSubLayerId].maxIndex           		= curGroupIndexOffset + amountSituationsAB[wAB][bAB] * amountSituationsCD[wCD][bCD] - 1;
+				layer[layerNum].subLayer[curSubLayerId].maxIndex           		= curGroupIndexOffset + static_cast<stateId>(amountSituationsAB[wAB][bAB]) * amountSituationsCD[wCD][bCD] - 1;
 				layer[layerNum].subLayer[curSubLayerId].numBlackStonesGroupAB  	= bAB;
 				layer[layerNum].subLayer[curSubLayerId].numBlackStonesGroupCD  	= bCD;
 				layer[layerNum].subLayer[curSubLayerId].numWhiteStonesGroupAB  	= wAB;
@@ -443,7 +587,7 @@ void stateAddressing::initLayerRegardingSettingPhase()
 				layer[layerNum].subLayerIndexAB[wAB][bAB]                       = NOT_INDEXED;
 				layer[layerNum].subLayerIndexCD[wCD][bCD]                       = curSubLayerId;
 				layer[layerNum].numSubLayers++;
-				curGroupIndexOffset 										   += amountSituationsAB[wAB][bAB] * amountSituationsCD[wCD][bCD];
+				curGroupIndexOffset 										   += static_cast<stateId>(amountSituationsAB[wAB][bAB]) * amountSituationsCD[wCD][bCD];
 				curSubLayerId++;				
 			}}
 
@@ -593,6 +737,9 @@ bool stateAddressing::applySymmetryTransfToField(symOperationId symmetryOperatio
 	fieldStruct::millArray tmpStonePartOfMill = field.stonePartOfMill;
 	applySymmetryTransfToField(symmetryOperationNumber, doInverseOperation, tmpStonePartOfMill, field.stonePartOfMill);
 
+	// ... and the bit masks of the players
+	field.calcStoneMasks();
+
 	return true;
 }
 
@@ -621,6 +768,15 @@ stateAddressing::layerId stateAddressing::getLayerNumber(const fieldStruct::core
 	return getLayerNumber(field.curPlayer.numStones, field.oppPlayer.numStones, field.settingPhase);
 }
 
+//-----------------------------------------------------------------------------
+// Name: getLayerNumber()
+// Desc: Returns the layer number for a given packed field
+//-----------------------------------------------------------------------------
+stateAddressing::layerId stateAddressing::getLayerNumber(const fieldStruct::packedCore& field) const
+{
+	return getLayerNumber(field.getCurPlayerNumStones(), field.getOppPlayerNumStones(), field.inSettingPhase());
+}
+
 //-----------------------------------------------------------------------------
 // Name: getLayerNumber()
 // Desc: Returns the layer number for a given number of white and black stones 
@@ -686,11 +842,8 @@ bool stateAddressing::getStateNumber(layerId layerNum, stateId& stateNumber, sym
 {
     // locals
 	fieldStruct::fieldArray myField;
-    fieldStruct::fieldArray symField;
 	numWhiteStones			wCD;
 	numBlackStones			bCD;
-    groupStateNumber		stateAB;
-	groupStateNumber		stateCD;
 
 	// the state numbers assumes that the current player is always player white (2)
 	// thus we have to convert the field to this assumption
@@ -699,11 +852,207 @@ bool stateAddressing::getStateNumber(layerId layerNum, stateId& stateNumber, sym
 	// count stones in each group
 	countStonesInGroupCD(field, wCD, bCD);
 
-    // calc stateCD
-	calcGroupStateNumberCD(myField, stateCD);
+	calcStateNumber(layerNum, stateNumber, symOp, myField, wCD, bCD);
+
+	// consider offset based on totalNumMissingStones
+	if (isSettingPhase(layerNum)) {
+		if (!addTotalNumMissingStonesOffset(stateNumber, field)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getStateNumber()
+// Desc: Returns the state number for a given packed field. 
+//       The stones of each player are taken directly from the occupancy masks.
+//-----------------------------------------------------------------------------
+bool stateAddressing::getStateNumber(layerId layerNum, stateId& stateNumber, symOperationId& symOp, const fieldStruct::packedCore& field) const
+{
+    // locals
+	fieldStruct::fieldArray myField;
+	const bitBoard			curPlayerStones	= field.getCurPlayerStones();
+	const bitBoard			oppPlayerStones	= field.getOppPlayerStones();
+	const numWhiteStones	wCD				= std::popcount(curPlayerStones & squaresOfGroupCD);
+	const numBlackStones	bCD				= std::popcount(oppPlayerStones & squaresOfGroupCD);
+
+	// the current player is always player white (2)
+	myField.fill(playerId::squareIsFree);
+	for (bitBoard squares = curPlayerStones; squares; ) myField[fieldStruct::popSquare(squares)] = fieldStruct::playerWhite;
+	for (bitBoard squares = oppPlayerStones; squares; ) myField[fieldStruct::popSquare(squares)] = fieldStruct::playerBlack;
+
+	calcStateNumber(layerNum, stateNumber, symOp, myField, wCD, bCD);
+
+	// consider offset based on totalNumMissingStones
+	if (isSettingPhase(layerNum)) {
+		if (!addTotalNumMissingStonesOffset(stateNumber, field.getCurPlayerNumStonesMissing(), field.getOppPlayerNumStonesMissing(), field.getCurPlayerNumStones(), field.getOppPlayerNumStones())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getStateNumbers()
+// Desc: Returns the layer, state number and symmetry operation of each packed field, equal to getLayerNumber() and getStateNumber().
+//       The fields are processed in batches of stateNumberBatchSize. Within a batch all group state numbers are calculated first,
+//       so that the independent lookups into the large tables groupIndexCD and symmetryOperationCD of all fields are in flight at the same time.
+//       Returns false if any of the fields cannot be addressed, whose result is marked by layerNum being NOT_INDEXED.
+//-----------------------------------------------------------------------------
+bool stateAddressing::getStateNumbers(const fieldStruct::packedCore* fields, size_t numFields, stateNumberStruct* results) const
+{
+	// locals
+	bool										allValid	= true;
+	array<bitBoard,			stateNumberBatchSize>	curPlayerStones;
+	array<bitBoard,			stateNumberBatchSize>	oppPlayerStones;
+	array<groupStateNumber,	stateNumberBatchSize>	stateCD;
+	array<groupIndex,		stateNumberBatchSize>	indexCD;
+	array<symOperationId,	stateNumberBatchSize>	symOp;
+
+	for (size_t first = 0; first < numFields; first += stateNumberBatchSize) {
+
+		const unsigned int batchSize = (numFields - first < stateNumberBatchSize) ? static_cast<unsigned int>(numFields - first) : stateNumberBatchSize;
+
+		// group state number of group C&D, with the current player always being player white (2)
+		for (unsigned int i = 0; i < batchSize; i++) {
+			curPlayerStones[i] 	= fields[first + i].getCurPlayerStones();
+			oppPlayerStones[i] 	= fields[first + i].getOppPlayerStones();
+			stateCD[i] 			= 0;
+			for (bitBoard squares = curPlayerStones[i] & squaresOfGroupCD; squares; ) stateCD[i] += static_cast<groupStateNumber>(fieldStruct::playerWhite) * squareWeightCD[fieldStruct::popSquare(squares)];
+			for (bitBoard squares = oppPlayerStones[i] & squaresOfGroupCD; squares; ) stateCD[i] += static_cast<groupStateNumber>(fieldStruct::playerBlack) * squareWeightCD[fieldStruct::popSquare(squares)];
+		}
+
+		// independent loads from the large tables
+		if (engine == rankingEngine::lookupTables) {
+			for (unsigned int i = 0; i < batchSize; i++) {
+				symOp[i] 	= symmetryOperationCD[stateCD[i]];
+				indexCD[i] 	= groupIndexCD[stateCD[i]];
+			}
+		} else {
+			for (unsigned int i = 0; i < batchSize; i++) {
+				findOriginalStateCD(curPlayerStones[i], oppPlayerStones[i], std::popcount(curPlayerStones[i] & squaresOfGroupCD), std::popcount(oppPlayerStones[i] & squaresOfGroupCD), indexCD[i], symOp[i]);
+			}
+		}
+
+		// group state number of group A&B after applying the symmetry operation, and the resulting state number
+		for (unsigned int i = 0; i < batchSize; i++) {
+
+			const fieldStruct::packedCore&	field		= fields[first + i];
+			stateNumberStruct&				result		= results[first + i];
+			const auto&						symMap		= symmetryTransformationTable[symOp[i]];
+			const numWhiteStones			wCD			= std::popcount(curPlayerStones[i] & squaresOfGroupCD);
+			const numBlackStones			bCD			= std::popcount(oppPlayerStones[i] & squaresOfGroupCD);
+			groupStateNumber				stateAB		= 0;
+
+			// the symmetric field takes the stone of square symMap[pos] for square pos
+			auto getDigit = [&](fieldStruct::fieldPos pos) {
+				return static_cast<groupStateNumber>((curPlayerStones[i] >> symMap[pos]) & 1) * static_cast<groupStateNumber>(fieldStruct::playerWhite)
+					 + static_cast<groupStateNumber>((oppPlayerStones[i] >> symMap[pos]) & 1) * static_cast<groupStateNumber>(fieldStruct::playerBlack);
+			};
+			for (fieldStruct::fieldPos pos : squareIndexGroupA) stateAB += getDigit(pos) * squareWeightAB[pos];
+			for (fieldStruct::fieldPos pos : squareIndexGroupB) stateAB += getDigit(pos) * squareWeightAB[pos];
+
+			result.layerNum					= getLayerNumber(field);
+			const layerStruct&	curLayer	= layer[result.layerNum];
+			result.stateNumber				= curLayer.subLayer[curLayer.subLayerIndexCD[wCD][bCD]].minIndex + static_cast<stateId>(groupIndexAB[stateAB]) * amountSituationsCD[wCD][bCD] + indexCD[i];
+			result.symOp					= symOp[i];
+
+			// consider offset based on totalNumMissingStones
+			if (isSettingPhase(result.layerNum)) {
+				if (!addTotalNumMissingStonesOffset(result.stateNumber, field.getCurPlayerNumStonesMissing(), field.getOppPlayerNumStonesMissing(), field.getCurPlayerNumStones(), field.getOppPlayerNumStones())) {
+					result 		= stateNumberStruct{};
+					allValid 	= false;
+				}
+			}
+		}
+	}
+	return allValid;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getStateNumbers()
+// Desc: Returns the layer, state number and symmetry operation of each packed field. See above.
+//-----------------------------------------------------------------------------
+bool stateAddressing::getStateNumbers(const std::vector<fieldStruct::packedCore>& fields, std::vector<stateNumberStruct>& results) const
+{
+	results.resize(fields.size());
+	return getStateNumbers(fields.data(), fields.size(), results.data());
+}
+
+//-----------------------------------------------------------------------------
+// Name: findOriginalStateCD()
+// Desc: Returns the same group index and symmetry operation as groupIndexCD and symmetryOperationCD, but without these tables.
+//		 The symmetric group state numbers are compared to find the original state, being the lowest one. Its group index is its position within groupStateCD.
+//		 'whiteStones' and 'blackStones' may contain squares of group A&B, which are ignored.
+//-----------------------------------------------------------------------------
+void stateAddressing::findOriginalStateCD(bitBoard whiteStones, bitBoard blackStones, numWhiteStones wCD, numBlackStones bCD, groupIndex& indexCD, symOperationId& symOp) const
+{
+	// locals
+	array<groupStateNumber, NUM_SYM_OPERATIONS>	symStateCD;
+	groupStateNumber							originalStateCD;
+
+	// the current player is always player white (2)
+	for (symOperationId op = 0; op < NUM_SYM_OPERATIONS; op++) {
+		const auto& stateOfByte = symmetricStateOfByteCD[op];
+		symStateCD[op] = 0;
+		for (unsigned int byte = 0; byte < numBytesPerBitBoard; byte++) {
+			symStateCD[op] += static_cast<groupStateNumber>(fieldStruct::playerWhite) * stateOfByte[byte][(whiteStones >> (8 * byte)) & 0xFF]
+							+ static_cast<groupStateNumber>(fieldStruct::playerBlack) * stateOfByte[byte][(blackStones >> (8 * byte)) & 0xFF];
+		}
+	}
+	originalStateCD = symStateCD[SO_DO_NOTHING];
+	for (symOperationId op = 0; op < NUM_SYM_OPERATIONS; op++) {
+		originalStateCD = (symStateCD[op] < originalStateCD) ? symStateCD[op] : originalStateCD;
+	}
+
+	// same choice as in init_group_CD(), if several symmetry operations lead to the original state
+	if (originalStateCD == symStateCD[SO_DO_NOTHING]) {
+		symOp = SO_DO_NOTHING;
+	} else {
+		symOperationId highestSymOp = 0;
+		for (symOperationId op = 0; op < NUM_SYM_OPERATIONS; op++) {
+			if (symStateCD[op] != originalStateCD) continue;
+			if (reverseSymOperation[op] >= highestSymOp) highestSymOp = reverseSymOperation[op];
+		}
+		symOp = reverseSymOperation[highestSymOp];
+	}
+
+	// the original states are listed in ascending order
+	const groupStateNumber* first	= &groupStateCD.state[groupStateCD.offset[wCD * (NUM_STONES_PER_PLAYER+1) + bCD]];
+	const groupStateNumber* last	= first + amountSituationsCD[wCD][bCD];
+	indexCD = static_cast<groupIndex>(lower_bound(first, last, originalStateCD) - first);
+}
+
+//-----------------------------------------------------------------------------
+// Name: calcStateNumber()
+// Desc: Calculates the state number without the offset for the missing stones.
+//       'myField' must already be adapted to the current player being player white (2).
+//-----------------------------------------------------------------------------
+void stateAddressing::calcStateNumber(layerId layerNum, stateId& stateNumber, symOperationId& symOp, const fieldStruct::fieldArray& myField, numWhiteStones wCD, numBlackStones bCD) const
+{
+    // locals
+    fieldStruct::fieldArray symField;
+    groupStateNumber		stateAB;
+	groupStateNumber		stateCD;
+	groupIndex				indexCD;
+
+    // calc index and symmetry operation of group C&D
+	if (engine == rankingEngine::lookupTables) {
+		calcGroupStateNumberCD(myField, stateCD);
+		indexCD	= groupIndexCD[stateCD];
+		symOp	= symmetryOperationCD[stateCD];
+	} else {
+		bitBoard whiteStones = 0, blackStones = 0;
+		for (auto pos : squareIndexGroupC) { if (myField[pos] == fieldStruct::playerWhite) whiteStones |= fieldStruct::squareMask(pos); if (myField[pos] == fieldStruct::playerBlack) blackStones |= fieldStruct::squareMask(pos); }
+		for (auto pos : squareIndexGroupD) { if (myField[pos] == fieldStruct::playerWhite) whiteStones |= fieldStruct::squareMask(pos); if (myField[pos] == fieldStruct::playerBlack) blackStones |= fieldStruct::squareMask(pos); }
+		findOriginalStateCD(whiteStones, blackStones, wCD, bCD, indexCD, symOp);
+	}
 
     // apply symmetry operation on group A&B
-    applySymmetryTransfToField(symmetryOperationCD[stateCD], false, myField, symField);
+    applySymmetryTransfToField(symOp, false, myField, symField);
 
 	// calc stateAB
 	// Optimized: unroll loop and use pointer arithmetic for better cache locality
@@ -719,19 +1068,9 @@ bool stateAddressing::getStateNumber(layerId layerNum, stateId& stateNumber, sym
 	}
 
     // calc index
-	const unsigned int 	stateNumberWithInSubLayer 	= groupIndexAB[stateAB] * amountSituationsCD[wCD][bCD] + groupIndexCD[stateCD];
+	const stateId 		stateNumberWithInSubLayer 	= static_cast<stateId>(groupIndexAB[stateAB]) * amountSituationsCD[wCD][bCD] + indexCD;
 	const subLayerId 	subLayerIndexCD 			= layer[layerNum].subLayerIndexCD[wCD][bCD];
 						stateNumber 				= (layer[layerNum].subLayer[subLayerIndexCD].minIndex + stateNumberWithInSubLayer);
-    					symOp 						= symmetryOperationCD[stateCD];
-
-	// consider offset based on totalNumMissingStones
-	if (isSettingPhase(layerNum)) {
-		if (!addTotalNumMissingStonesOffset(stateNumber, field)) {
-			return false;
-		}
-	}
-
-	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -770,10 +1109,17 @@ void stateAddressing::countStonesInGroupCD(const fieldStruct::core& field, numWh
 // Desc: Adds the statenumber offset based on the total number of missing stones
 //-----------------------------------------------------------------------------
 bool stateAddressing::addTotalNumMissingStonesOffset(stateId& stateNumber, const fieldStruct::core& field) const
+{
+	return addTotalNumMissingStonesOffset(stateNumber, field.getCurPlayer().numStonesMissing, field.getOppPlayer().numStonesMissing, field.getCurPlayer().numStones, field.getOppPlayer().numStones);
+}
+
+//-----------------------------------------------------------------------------
+// Name: addTotalNumMissingStonesOffset()
+// Desc: Adds the statenumber offset based on the number of missing stones and the number of stones on the field of each player
+//-----------------------------------------------------------------------------
+bool stateAddressing::addTotalNumMissingStonesOffset(stateId& stateNumber, unsigned int nsm_curPlayer, unsigned int nsm_oppPlayer, numWhiteStones numStonesCurPlayer, numBlackStones numStonesOppPlayer) const
 {
 	// locals
-	unsigned int nsm_curPlayer 			= field.getCurPlayer().numStonesMissing;
-	unsigned int nsm_oppPlayer 			= field.getOppPlayer().numStonesMissing;
 	unsigned int totalNumMissingStones 	= nsm_curPlayer + nsm_oppPlayer;
 
 	// at maximum 2 stones can be removed from closed mills in total
@@ -782,7 +1128,7 @@ bool stateAddressing::addTotalNumMissingStonesOffset(stateId& stateNumber, const
 	}
 
 	// add offset
-	stateNumber = stateNumber * getMaxTotalNumMissingStones(field.getCurPlayer().numStones, field.getOppPlayer().numStones) + totalNumMissingStones;
+	stateNumber = stateNumber * getMaxTotalNumMissingStones(numStonesCurPlayer, numStonesOppPlayer) + totalNumMissingStones;
 
 	return true;
 }
@@ -817,7 +1163,7 @@ bool stateAddressing::getFieldByStateNumber(layerId layerNum, stateId stateNumbe
 	const bool 				settingPhase 				= isSettingPhase(layerNum);
 	const layerStruct& 		curLayer 					= layer[layerNum];
 	const unsigned int 		totalNumMissingStones		= getTotalNumMissingStones(stateNumber, settingPhase, curLayer.amountWhiteStones, curLayer.amountBlackStones);
-    unsigned int 			stateNumberWithInSubLayer;
+    stateId 				stateNumberWithInSubLayer;
     groupIndex 				indexWithInGroupAB;
     groupIndex 				indexWithInGroupCD;
     groupStateNumber		stateAB, stateCD;
@@ -833,20 +1179,17 @@ bool stateAddressing::getFieldByStateNumber(layerId layerNum, stateId stateNumbe
     // get index within groups
 	subLayerIndexCD 		  = curLayer.subLayerIndexCD[wCD][bCD];
     stateNumberWithInSubLayer = curLayer.getStateNumberWithInSubLayer(stateNumber, settingPhase) - curLayer.subLayer[subLayerIndexCD].minIndex;
-    indexWithInGroupAB        = stateNumberWithInSubLayer / amountSituationsCD[wCD][bCD];
-    indexWithInGroupCD        = stateNumberWithInSubLayer % amountSituationsCD[wCD][bCD];
+    indexWithInGroupAB        = static_cast<groupIndex>(stateNumberWithInSubLayer / amountSituationsCD[wCD][bCD]);
+    indexWithInGroupCD        = static_cast<groupIndex>(stateNumberWithInSubLayer % amountSituationsCD[wCD][bCD]);
 
     // get state within groups
-    stateCD = groupStateCD[wCD][bCD][indexWithInGroupCD];
-    stateAB = groupStateAB[wAB][bAB][indexWithInGroupAB];
-
-	// set myField from stateAB
-	calcFieldBasedOnGroupAB(myField, stateAB);
+    stateCD = groupStateCD(wCD, bCD, indexWithInGroupCD);
+    stateAB = groupStateAB(wAB, bAB, indexWithInGroupAB);
 
-	// apply symmetry operation on group A&B
-    applySymmetryTransfToField(symmetryOperationCD[stateCD], true, myField, symField);
+	// set the stones of group A&B. no symmetry operation is applied, since the states listed in groupStateCD are the original ones with SO_DO_NOTHING.
+	calcFieldBasedOnGroupAB(symField, stateAB);
 
-	// set myField from stateCD
+	// set the stones of group C&D
 	calcFieldBasedOnGroupCD(symField, stateCD);
 
 	// the state numbers assumes that the current player is always player white
@@ -862,7 +1205,7 @@ bool stateAddressing::getFieldByStateNumber(layerId layerNum, stateId stateNumbe
 // Name: layerStruct::getStateNumberWithInSubLayer()
 // Desc: 
 //-----------------------------------------------------------------------------
-unsigned int stateAddressing::layerStruct::getStateNumberWithInSubLayer(stateId stateNumber, bool settingPhase) const
+stateAddressing::stateId stateAddressing::layerStruct::getStateNumberWithInSubLayer(stateId stateNumber, bool settingPhase) const
 {
 	return settingPhase ? stateNumber / stateAddressing::getMaxTotalNumMissingStones(amountWhiteStones, amountBlackStones) : stateNumber;
 }
@@ -873,7 +1216,7 @@ unsigned int stateAddressing::layerStruct::getStateNumberWithInSubLayer(stateId
 //-----------------------------------------------------------------------------
 unsigned int stateAddressing::getTotalNumMissingStones(stateId stateNumber, bool settingPhase, numWhiteStones amountWhiteStones, numBlackStones amountBlackStones) const
 {
-	return settingPhase ? stateNumber % getMaxTotalNumMissingStones(amountWhiteStones, amountBlackStones) : 0;
+	return settingPhase ? static_cast<unsigned int>(stateNumber % getMaxTotalNumMissingStones(amountWhiteStones, amountBlackStones)) : 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -882,7 +1225,7 @@ unsigned int stateAddressing::getTotalNumMissingStones(stateId stateNumber, bool
 //-----------------------------------------------------------------------------
 void stateAddressing::layerStruct::getNumGroupStonesByStateNumber(stateId stateNumber, bool settingPhase, numWhiteStones &numWhiteStonesGroupAB, numBlackStones &numBlackStonesGroupAB, numWhiteStones &numWhiteStonesGroupCD, numBlackStones &numBlackStonesGroupCD) const
 {
-	unsigned int stateNumberWithInSubLayer = layerStruct::getStateNumberWithInSubLayer(stateNumber, settingPhase);
+	stateId stateNumberWithInSubLayer = layerStruct::getStateNumberWithInSubLayer(stateNumber, settingPhase);
     for (subLayerId subLayerIndexCD=0; subLayerIndexCD<=numSubLayers; subLayerIndexCD++) {
         if (subLayer[subLayerIndexCD].minIndex <= stateNumberWithInSubLayer
          && subLayer[subLayerIndexCD].maxIndex >= stateNumberWithInSubLayer) {
@@ -915,6 +1258,15 @@ bool stateAddressing::isSymOperationInvariant(symOperationId symmetryOperation,
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Name: getRankingEngine()
+// Desc: Returns the way of determining the group index and the symmetry operation of group C&D, chosen on construction.
+//-----------------------------------------------------------------------------
+stateAddressing::rankingEngine stateAddressing::getRankingEngine() const
+{
+	return engine;
+}
+
 //-----------------------------------------------------------------------------
 // Name: getLayer()
 // Desc: Returns the layer containing further information for a given number
@@ -928,13 +1280,13 @@ const stateAddressing::layerStruct &stateAddressing::getLayer(layerId layerNum)
 // Name: getNumberOfKnotsInLayer()
 // Desc: Returns the number of knots in a given layer
 //-----------------------------------------------------------------------------
-unsigned int stateAddressing::getNumberOfKnotsInLayer(layerId layerNum) const
+stateAddressing::stateId stateAddressing::getNumberOfKnotsInLayer(layerId layerNum) const
 {
 	// checks
 	if (layerNum >= stateAddressing::NUM_LAYERS) return 0;
 
     // locals
-    unsigned int numberOfKnots = layer[layerNum].subLayer[layer[layerNum].numSubLayers - 1].maxIndex + 1;
+    stateId numberOfKnots = layer[layerNum].subLayer[layer[layerNum].numSubLayers - 1].maxIndex + 1;
 
 	// during setting phase removal of stones from closed mills lead to different states, which must be distuinguished
 	if (isSettingPhase(layerNum)) {
@@ -944,14 +1296,13 @@ unsigned int stateAddressing::getNumberOfKnotsInLayer(layerId layerNum) const
 			return 0;
 		}
 
-		// consider offset based on totalNumMissingStones
-		// use uint64_t to avoid overflow		
-		uint64_t knots64 = static_cast<uint64_t>(numberOfKnots) * getMaxTotalNumMissingStones(layer[layerNum].amountWhiteStones, layer[layerNum].amountBlackStones);
-		if (knots64 > std::numeric_limits<unsigned int>::max()) {
-			cout << "Error: Number of knots " << knots64 << " exceeds unsigned int range for layer " << layerNum << endl;
-			assert(false && "Number of knots exceeds unsigned int range");
+		// consider offset based on totalNumMissingStones. the state numbers must not wrap around, since they would address other states.
+		const unsigned int maxTotalNumMissingStones = getMaxTotalNumMissingStones(layer[layerNum].amountWhiteStones, layer[layerNum].amountBlackStones);
+		if (maxTotalNumMissingStones && numberOfKnots > std::numeric_limits<stateId>::max() / maxTotalNumMissingStones) {
+			cout << "Error: Number of knots in layer " << layerNum << " exceeds the range of stateId. Define MUEHLE_STATE_ID_64." << endl;
+			return 0;
 		}
-		numberOfKnots = static_cast<unsigned int>(knots64);
+		numberOfKnots *= maxTotalNumMissingStones;
 	}
 
 	// during moving phase, we have to check if the layer is reachable
@@ -966,48 +1317,268 @@ unsigned int stateAddressing::getNumberOfKnotsInLayer(layerId layerNum) const
 }
 
 //-----------------------------------------------------------------------------
-// Name: getSymmetricStateNumbers()
-// Desc: Returns the state numbers of all symmetric states for a given field
+// Name: getStateNumbersOfSymmetricStates()
+// Desc: Returns the state numbers of all symmetric states for a given field: [symmetry operation] -> state number of the symmetric field.
+//       Symmetry operations changing group C&D yield the state number of the field itself. See getSymmetricImages().
 //-----------------------------------------------------------------------------
 bool stateAddressing::getStateNumbersOfSymmetricStates(const fieldStruct::core& field, std::array<stateId, NUM_SYM_OPERATIONS>& stateNumbers) const
 {
-	// save current field
-	symOperationId 				symmetryOperation;
-	symOperationId 				symOpApplied;
-	fieldStruct::core 			symField;
-	layerId		 				layerNumber = getLayerNumber(field);
-	stateId 					stateNumber;
-	
-	// get state number of current field
-	if (!getStateNumber(layerNumber, stateNumber, symmetryOperation, field)) {
+	// locals
+	array<fieldStruct::packedCore,	NUM_SYM_OPERATIONS>	images;
+	array<symOperationId,			NUM_SYM_OPERATIONS>	symOpOfImage;
+	array<unsigned int,				NUM_SYM_OPERATIONS>	imageOfSymOp;
+	array<stateNumberStruct,		NUM_SYM_OPERATIONS>	results;
+	const unsigned int 									numImages = getSymmetricImages(fieldStruct::packedCore{field}, images, symOpOfImage, imageOfSymOp);
+
+	// rank all distinct images at once
+	if (!getStateNumbers(images.data(), numImages, results.data())) {
 		return false;
 	}
-	symField = field;
+	for (symOperationId symOp = 0; symOp < NUM_SYM_OPERATIONS; symOp++) {
+		stateNumbers[symOp] = results[imageOfSymOp[symOp]].stateNumber;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getUniqueSymmetricStates()
+// Desc: Returns the distinct states, which represent the given field or any symmetric field. The first one is the state of the field itself.
+//       The symmetry operation of each state turns the given field into the one represented by the state number.
+//       Returns the number of states, or 0 if the field cannot be addressed.
+//-----------------------------------------------------------------------------
+unsigned int stateAddressing::getUniqueSymmetricStates(const fieldStruct::packedCore& field, std::array<stateNumberStruct, NUM_SYM_OPERATIONS>& symStates) const
+{
+	// locals
+	array<fieldStruct::packedCore,	NUM_SYM_OPERATIONS>	images;
+	array<symOperationId,			NUM_SYM_OPERATIONS>	symOpOfImage;
+	array<unsigned int,				NUM_SYM_OPERATIONS>	imageOfSymOp;
+	array<stateNumberStruct,		NUM_SYM_OPERATIONS>	results;
+	const unsigned int 									numImages = getSymmetricImages(field, images, symOpOfImage, imageOfSymOp);
+	unsigned int										numStates = 0;
+
+	// rank all distinct images at once
+	if (!getStateNumbers(images.data(), numImages, results.data())) {
+		return 0;
+	}
 
-	// add all symmetric states
-	for (symmetryOperation=0; symmetryOperation<stateAddressing::NUM_SYM_OPERATIONS; symmetryOperation++) {
+	// distinct images might still be represented by the same state
+	for (unsigned int i = 0; i < numImages; i++) {
+		unsigned int j = 0;
+		while (j < numStates && symStates[j].stateNumber != results[i].stateNumber) j++;
+		if (j < numStates) continue;
 
-		// set state number to the state without any sym operation
-		stateNumbers[symmetryOperation] = stateNumber;
+		// there are two symmetry operations: the one applied to the field and the one applied due to mapping to the state number
+		symStates[numStates]		= results[i];
+		symStates[numStates].symOp	= concSymOperation[symOpOfImage[i]][results[i].symOp];
+		numStates++;
+	}
+	return numStates;
+}
 
-		// TODO: check if this is really correct. Shouldn't it be rather:
-		// if (symmetryOperation != SO_DO_NOTHING && isSymOperationInvariant(symmetryOperation, field)) {
-		// 	continue;
-		// }
-		// only add if sym operation is invariant
-		if (!isSymOperationInvariant(symmetryOperation, field)) {
-			continue;
+//-----------------------------------------------------------------------------
+// Name: getSymmetricImages()
+// Desc: Applies all symmetry operations to the bit boards of the field and returns the distinct images, starting with the field itself.
+//       Only the images with the same group C&D as the field are needed: Any other image is mapped by symmetryOperationCD onto the 
+//       same group C&D, and thus onto a state of one of those images. imageOfSymOp is 0 for symmetry operations changing group C&D.
+//-----------------------------------------------------------------------------
+unsigned int stateAddressing::getSymmetricImages(const fieldStruct::packedCore& field, std::array<fieldStruct::packedCore, NUM_SYM_OPERATIONS>& images, std::array<symOperationId, NUM_SYM_OPERATIONS>& symOpOfImage, std::array<unsigned int, NUM_SYM_OPERATIONS>& imageOfSymOp) const
+{
+	// locals
+	const bitBoard	curPlayerStones	= field.getCurPlayerStones();
+	const bitBoard	oppPlayerStones	= field.getOppPlayerStones();
+	unsigned int	numImages		= 1;
+
+	images[0]		= field;
+	symOpOfImage[0]	= SO_DO_NOTHING;
+
+	for (symOperationId symOp = 0; symOp < NUM_SYM_OPERATIONS; symOp++) {
+
+		const bitBoard symCurPlayerStones = applySymmetryTransfToBitBoard(symOp, curPlayerStones);
+		const bitBoard symOppPlayerStones = applySymmetryTransfToBitBoard(symOp, oppPlayerStones);
+		imageOfSymOp[symOp] = 0;
+
+		// group C&D changed?
+		if (((symCurPlayerStones ^ curPlayerStones) | (symOppPlayerStones ^ oppPlayerStones)) & squaresOfGroupCD) continue;
+
+		// add image, if not already present
+		const fieldStruct::packedCore image = field.withStones(symCurPlayerStones, symOppPlayerStones);
+		unsigned int i = 0;
+		while (i < numImages && !(images[i] == image)) i++;
+		if (i == numImages) {
+			images[numImages]		= image;
+			symOpOfImage[numImages]	= symOp;
+			numImages++;
 		}
+		imageOfSymOp[symOp] = i;
+	}
+	return numImages;
+}
 
-		// appy symmetry operation
-		applySymmetryTransfToField(symmetryOperation, false, field.field, symField.field);
+//-----------------------------------------------------------------------------
+// Name: applySymmetryTransfToBitBoard()
+// Desc: Returns the squares after applying a symmetry operation, equal to applySymmetryTransfToField() on a field array.
+//-----------------------------------------------------------------------------
+bitBoard stateAddressing::applySymmetryTransfToBitBoard(symOperationId symmetryOperation, bitBoard squares) const
+{
+	const auto& permutation = symmetryPermutationTable[symmetryOperation];
+	bitBoard	symSquares	= 0;
+	for (unsigned int byte = 0; byte < numBytesPerBitBoard; byte++) {
+		symSquares |= permutation[byte][(squares >> (8 * byte)) & 0xFF];
+	}
+	return symSquares;
+}
 
-		// store state number
-		if (!getStateNumber(layerNumber, stateNumbers[symmetryOperation], symOpApplied, symField)) {
-			return false;
+#pragma endregion
+
+#pragma region layerIterator
+
+//-----------------------------------------------------------------------------
+// Name: getGroupBitBoards()
+// Desc: Returns the squares of the white and black stones of a group state number, given the weight 3^i of each square.
+//-----------------------------------------------------------------------------
+stateAddressing::groupBitBoardsStruct stateAddressing::getGroupBitBoards(const std::array<groupStateNumber, fieldStruct::size>& squareWeights, groupStateNumber state)
+{
+	groupBitBoardsStruct bitBoards;
+	for (fieldStruct::fieldPos pos = 0; pos < fieldStruct::size; pos++) {
+		if (!squareWeights[pos]) continue;
+		const playerId stone = static_cast<playerId>((state / squareWeights[pos]) % 3);
+		if (stone == fieldStruct::playerWhite) bitBoards.white |= fieldStruct::squareMask(pos);
+		if (stone == fieldStruct::playerBlack) bitBoards.black |= fieldStruct::squareMask(pos);
+	}
+	return bitBoards;
+}
+
+const std::array<stateAddressing::groupBitBoardsStruct, stateAddressing::MAX_NUM_SITUATIONS_A * stateAddressing::MAX_NUM_SITUATIONS_B> stateAddressing::bitBoardsOfGroupAB = []() {
+	std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_A * MAX_NUM_SITUATIONS_B> bitBoards;
+	for (groupStateNumber stateAB = 0; stateAB < bitBoards.size(); stateAB++) bitBoards[stateAB] = getGroupBitBoards(squareWeightAB, stateAB);
+	return bitBoards;
+}();
+
+const std::array<stateAddressing::groupBitBoardsStruct, stateAddressing::MAX_NUM_SITUATIONS_D> stateAddressing::bitBoardsOfLowDigitsCD = []() {
+	std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_D> bitBoards;
+	for (groupStateNumber low = 0; low < bitBoards.size(); low++) bitBoards[low] = getGroupBitBoards(squareWeightCD, low);
+	return bitBoards;
+}();
+
+const std::array<stateAddressing::groupBitBoardsStruct, stateAddressing::MAX_NUM_SITUATIONS_C> stateAddressing::bitBoardsOfHighDigitsCD = []() {
+	std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_C> bitBoards;
+	for (groupStateNumber high = 0; high < bitBoards.size(); high++) bitBoards[high] = getGroupBitBoards(squareWeightCD, high * MAX_NUM_SITUATIONS_D);
+	return bitBoards;
+}();
+
+//-----------------------------------------------------------------------------
+// Name: layerIterator()
+// Desc: Iterates over the states from firstState to endState-1 of a layer. endState is limited to the number of states in the layer.
+//-----------------------------------------------------------------------------
+stateAddressing::layerIterator::layerIterator(const stateAddressing& sa, layerId layerNum, playerId curPlayer, stateId firstState, stateId endState) :
+	sa{sa},
+	layerNum{layerNum},
+	curLayer{sa.layer[(layerNum < NUM_LAYERS) ? layerNum : 0]},
+	settingPhase{sa.isSettingPhase(layerNum)},
+	maxTotalNumMissingStones{settingPhase ? getMaxTotalNumMissingStones(curLayer.amountWhiteStones, curLayer.amountBlackStones) : 1},
+	curPlayer{curPlayer},
+	oppPlayer{(curPlayer == playerId::playerOne) ? playerId::playerTwo : playerId::playerOne}
+{
+	this->endState = (endState < sa.getNumberOfKnotsInLayer(layerNum)) ? endState : sa.getNumberOfKnotsInLayer(layerNum);
+	myField.fill(playerId::squareIsFree);
+	field.reset(curPlayer);
+	stateNumber = this->endState;
+	if (firstState < this->endState) {
+		seek(firstState);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: seek()
+// Desc: Unranks the first state like getFieldByStateNumber().
+//-----------------------------------------------------------------------------
+void stateAddressing::layerIterator::seek(stateId firstState)
+{
+	// locals
+	numWhiteStones			wAB, wCD;
+	numBlackStones			bAB, bCD;
+
+	curLayer.getNumGroupStonesByStateNumber(firstState, settingPhase, wAB, bAB, wCD, bCD);
+	stateNumber 							= firstState;
+	totalNumMissingStones					= sa.getTotalNumMissingStones(firstState, settingPhase, curLayer.amountWhiteStones, curLayer.amountBlackStones);
+	subLayerIndex 							= curLayer.subLayerIndexCD[wCD][bCD];
+	const stateId stateWithInSubLayer		= curLayer.getStateNumberWithInSubLayer(firstState, settingPhase) - curLayer.subLayer[subLayerIndex].minIndex;
+	indexAB 								= static_cast<groupIndex>(stateWithInSubLayer / sa.amountSituationsCD[wCD][bCD]);
+	indexCD 								= static_cast<groupIndex>(stateWithInSubLayer % sa.amountSituationsCD[wCD][bCD]);
+	setGroupAB();
+	setGroupCD();
+	setSituation();
+}
+
+//-----------------------------------------------------------------------------
+// Name: next()
+// Desc: Steps to the next state number. Thereby the number of missing stones changes fastest, followed by the index within group C&D, the index within group A&B and the sublayer.
+//-----------------------------------------------------------------------------
+void stateAddressing::layerIterator::next()
+{
+	if (++stateNumber >= endState) return;
+
+	if (++totalNumMissingStones < maxTotalNumMissingStones) {
+		setSituation();
+		return;
+	}
+	totalNumMissingStones = 0;
+
+	const subLayerStruct& subLayer = curLayer.subLayer[subLayerIndex];
+	if (++indexCD >= sa.amountSituationsCD[subLayer.numWhiteStonesGroupCD][subLayer.numBlackStonesGroupCD]) {
+		indexCD = 0;
+		if (++indexAB >= sa.amountSituationsAB[subLayer.numWhiteStonesGroupAB][subLayer.numBlackStonesGroupAB]) {
+			indexAB = 0;
+
+			// skip empty sublayers
+			do { subLayerIndex++; } while (curLayer.subLayer[subLayerIndex].maxIndex + 1 == curLayer.subLayer[subLayerIndex].minIndex);
 		}
+		setGroupAB();
 	}
-	return true;
+	setGroupCD();
+	setSituation();
+}
+
+//-----------------------------------------------------------------------------
+// Name: setGroupAB()
+// Desc: Looks up the stones of group A&B. They are not transformed, since the states listed in groupStateCD are the original ones with SO_DO_NOTHING.
+//-----------------------------------------------------------------------------
+void stateAddressing::layerIterator::setGroupAB()
+{
+	const subLayerStruct& 		subLayer 	= curLayer.subLayer[subLayerIndex];
+	const groupStateNumber		stateAB		= sa.groupStateAB(subLayer.numWhiteStonesGroupAB, subLayer.numBlackStonesGroupAB, indexAB);
+	bitBoardsAB								= bitBoardsOfGroupAB[stateAB];
+}
+
+//-----------------------------------------------------------------------------
+// Name: setGroupCD()
+// Desc: Sets the stones of group C&D together with the stones of group A&B, changing only the squares which differ from the previous state.
+//-----------------------------------------------------------------------------
+void stateAddressing::layerIterator::setGroupCD()
+{
+	// locals
+	const subLayerStruct& 		subLayer 	= curLayer.subLayer[subLayerIndex];
+	const groupStateNumber		stateCD		= sa.groupStateCD(subLayer.numWhiteStonesGroupCD, subLayer.numBlackStonesGroupCD, indexCD);
+	const groupBitBoardsStruct&	lowDigits	= bitBoardsOfLowDigitsCD [stateCD % MAX_NUM_SITUATIONS_D];
+	const groupBitBoardsStruct&	highDigits	= bitBoardsOfHighDigitsCD[stateCD / MAX_NUM_SITUATIONS_D];
+	const groupBitBoardsStruct	newBitBoards{lowDigits.white | highDigits.white | bitBoardsAB.white, lowDigits.black | highDigits.black | bitBoardsAB.black};
+
+	for (bitBoard changed = (newBitBoards.white ^ bitBoards.white) | (newBitBoards.black ^ bitBoards.black); changed; ) {
+		const fieldStruct::fieldPos pos = fieldStruct::popSquare(changed);
+		if 		(newBitBoards.white & fieldStruct::squareMask(pos))	myField[pos] = curPlayer;
+		else if (newBitBoards.black & fieldStruct::squareMask(pos))	myField[pos] = oppPlayer;
+		else 														myField[pos] = playerId::squareIsFree;
+	}
+	bitBoards = newBitBoards;
+}
+
+//-----------------------------------------------------------------------------
+// Name: setSituation()
+// Desc: Passes the current squares and number of missing stones to the field.
+//-----------------------------------------------------------------------------
+void stateAddressing::layerIterator::setSituation()
+{
+	valid = field.setSituation(myField, settingPhase, totalNumMissingStones);
 }
 
 #pragma endregion
@@ -1021,109 +1592,311 @@ bool stateAddressing::getStateNumbersOfSymmetricStates(const fieldStruct::core&
 stateAddressing::cacheFile::cacheFile(std::wstring const &directory, stateAddressing &sa) :
 	sa(sa)
 {
-	// locals
-	wstringstream					ssPreCalcVarsFilePath;
-
 	// set file path
 	if (directory.size()) {
 		if (!filesystem::exists(directory)) {	
 			filesystem::create_directory(directory);
 		}
-		ssPreCalcVarsFilePath << directory << "\\"; 
+		filePath = filesystem::path(directory);
 	}
-	ssPreCalcVarsFilePath << "preCalculatedVars.dat";
-	filePath = ssPreCalcVarsFilePath.str();
-	
-	// Open File, which contains the precalculated vars
-	hFile = CreateFile(ssPreCalcVarsFilePath.str().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	filePath /= "preCalculatedVars.dat";
 }
 
 //-----------------------------------------------------------------------------
 // Name: ~cacheFile()
-// Desc:
+// Desc: The mapping of the file is owned by the stateAddressing, since groupIndexCD and symmetryOperationCD point into it.
 //-----------------------------------------------------------------------------
 stateAddressing::cacheFile::~cacheFile()
 {
-	// Close File
-	if (hFile != INVALID_HANDLE_VALUE && hFile != NULL) {
-		CloseHandle(hFile);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getSection()
+// Desc: Returns the entry of the section table, which is located behind the header. The file must have been validated.
+//-----------------------------------------------------------------------------
+const stateAddressing::cacheFile::sectionStruct& stateAddressing::cacheFile::getSection(unsigned int sectionNumber) const
+{
+	return reinterpret_cast<const sectionStruct*>(sa.cacheMapping.data() + sizeof(fileHeaderStruct))[sectionNumber];
+}
+
+//-----------------------------------------------------------------------------
+// Name: isMappedFileValid()
+// Desc: Checks the header, the section table and the checksum of the mapped file.
+//-----------------------------------------------------------------------------
+bool stateAddressing::cacheFile::isMappedFileValid() const
+{
+	// locals
+	fileHeaderStruct	header;
+	const size_t		tableEnd		= sizeof(fileHeaderStruct) + numSections * sizeof(sectionStruct);
+
+	// header
+	if (sa.cacheMapping.size() < tableEnd) 					return false;
+	std::memcpy(&header, sa.cacheMapping.data(), sizeof(header));
+	if (header.magic			!= fileMagic)				return false;
+	if (header.version			!= fileVersion)				return false;
+	if (header.endianness		!= endiannessMarker)		return false;
+	if (header.headerSize		!= sizeof(fileHeaderStruct))return false;
+	if (header.layerStructSize	!= sizeof(layerStruct))		return false;
+	if (header.numSections		!= numSections)				return false;
+	if (header.fileSize			!= sa.cacheMapping.size())	return false;
+
+	// section table
+	for (unsigned int sectionNumber = 0; sectionNumber < numSections; sectionNumber++) {
+		const sectionStruct& section = getSection(sectionNumber);
+		if (section.offset % sectionAlignment)				return false;
+		if (section.offset < tableEnd)						return false;
+		if (section.offset > header.fileSize)				return false;
+		if (section.sizeInBytes > header.fileSize - section.offset) return false;
 	}
+
+	// checksum
+	return header.checksum == calcChecksum(sa.cacheMapping.data() + sizeof(fileHeaderStruct), sa.cacheMapping.size() - sizeof(fileHeaderStruct));
+}
+
+//-----------------------------------------------------------------------------
+// Name: calcChecksum()
+// Desc: Fast checksum over 64 bit words using four independent lanes, so that a file of several hundred MB is checked in a fraction of a second.
+//-----------------------------------------------------------------------------
+std::uint64_t stateAddressing::cacheFile::calcChecksum(const unsigned char* data, size_t numBytes)
+{
+	// locals
+	const std::uint64_t	prime			= 0x9E3779B97F4A7C15ull;
+	std::uint64_t		lanes[4]		= { 0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull };
+	std::uint64_t		word;
+	std::uint64_t		hash			= numBytes;
+	size_t				pos				= 0;
+
+	auto mix = [prime](std::uint64_t lane, std::uint64_t word) {
+		lane = (lane ^ word) * prime;
+		return (lane << 31) | (lane >> 33);
+	};
+
+	for (; pos + sizeof(lanes) <= numBytes; pos += sizeof(lanes)) {
+		for (unsigned int lane = 0; lane < 4; lane++) {
+			std::memcpy(&word, data + pos + lane * sizeof(word), sizeof(word));
+			lanes[lane] = mix(lanes[lane], word);
+		}
+	}
+	for (; pos < numBytes; pos++) {
+		lanes[0] = mix(lanes[0], data[pos]);
+	}
+	for (unsigned int lane = 0; lane < 4; lane++) {
+		hash = mix(hash, lanes[lane]);
+	}
+	return hash;
 }
 
 //-----------------------------------------------------------------------------
 // Name: readFromFile()
-// Desc: Reads the precalculated variables from the file preCalculatedVars.dat
+// Desc: Maps the file preCalculatedVars.dat into memory and takes over the precalculated variables.
+//		 Returns false if the file does not exist or is invalid, so that the variables must be calculated.
 //-----------------------------------------------------------------------------
 bool stateAddressing::cacheFile::readFromFile()
 {
 	// locals
-	DWORD			dwBytesRead		= 0;
+	bool success = true;
 
-	// check if file is valid
-	if (hFile == INVALID_HANDLE_VALUE || hFile == NULL) {
+	if (!sa.cacheMapping.open(filePath)) {
 		return false;
 	}
+	if (!isMappedFileValid()) {
+		sa.cacheMapping.close();
+		return false;
+	}
+
+	success = success && readSection( 0, sa.layer);
+	success = success && readSection( 1, sa.layerIndex);
+	success = success && readSection( 2, sa.amountSituationsAB);
+	success = success && readSection( 3, sa.amountSituationsCD);
+	success = success && readSection( 4, sa.groupIndexAB);
+	if (sa.engine == rankingEngine::lookupTables) {
+		success = success && mapSection ( 5, sa.groupIndexCD, 			MAX_NUM_SITUATIONS_C * MAX_NUM_SITUATIONS_D);
+		success = success && mapSection ( 6, sa.symmetryOperationCD, 	MAX_NUM_SITUATIONS_C * MAX_NUM_SITUATIONS_D);
+	}
+	success = success && readSection( 7, sa.powerOfThree);
+	success = success && readSection( 8, sa.symmetryTransformationTable);
+	success = success && readSection( 9, sa.reverseSymOperation);
+	success = success && readSection(10, sa.concSymOperation);
+	success = success && readSection(11, sa.mOverN);
+	if (success) {
+		sa.resizeGroupStateMappingArray(sa.groupStateAB, nullptr, 				    numSquaresGroupA + numSquaresGroupB);
+		sa.resizeGroupStateMappingArray(sa.groupStateCD, &sa.amountSituationsCD, 	numSquaresGroupC + numSquaresGroupD);
+	}
+	success = success && readSection(12, sa.groupStateAB.state);
+	success = success && readSection(13, sa.groupStateCD.state);
+
+	// all other sections have been copied
+	if (!success || sa.engine != rankingEngine::lookupTables) {
+		sa.cacheMapping.close();
+	}
+	return success;
+}
 
-	// Read from file
-	ReadFile(hFile, &header, sizeof (header), &dwBytesRead, NULL);
+//-----------------------------------------------------------------------------
+// Name: writeToFile()
+// Desc: Writes the precalculated variables to the file preCalculatedVars.dat.
+//		 The file is written under a temporary name and renamed at the end, so that an aborted write never leaves a file, which seems to be valid.
+//-----------------------------------------------------------------------------
+bool stateAddressing::cacheFile::writeToFile()
+{
+	// locals
+	filesystem::path				tmpFilePath		= filePath;
+	fileHeaderStruct				header;
+	vector<sectionStruct>			sections;
+	mappedFile						tmpMapping;
+	error_code						errorCode;
+
+	tmpFilePath += ".tmp";
+
+	// write the sections, while the header and the section table are written afterwards
+	{
+		ofstream os(tmpFilePath, ios::binary | ios::trunc);
+		if (!os) return false;
+		os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (unsigned int sectionNumber = 0; sectionNumber < numSections; sectionNumber++) {
+			sectionStruct emptySection;
+			os.write(reinterpret_cast<const char*>(&emptySection), sizeof(emptySection));
+		}
+		writeSection(os, sections, sa.layer);
+		writeSection(os, sections, sa.layerIndex);
+		writeSection(os, sections, sa.amountSituationsAB);
+		writeSection(os, sections, sa.amountSituationsCD);
+		writeSection(os, sections, sa.groupIndexAB);
+		writeSection(os, sections, sa.groupIndexCD);
+		writeSection(os, sections, sa.symmetryOperationCD);
+		writeSection(os, sections, sa.powerOfThree);
+		writeSection(os, sections, sa.symmetryTransformationTable);
+		writeSection(os, sections, sa.reverseSymOperation);
+		writeSection(os, sections, sa.concSymOperation);
+		writeSection(os, sections, sa.mOverN);
+		writeSection(os, sections, sa.groupStateAB.state);
+		writeSection(os, sections, sa.groupStateCD.state);
+		header.fileSize = static_cast<std::uint64_t>(os.tellp());
+		os.seekp(sizeof(header));
+		os.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(sectionStruct));
+		if (!os) {
+			os.close();
+			filesystem::remove(tmpFilePath, errorCode);
+			return false;
+		}
+	}
 
-	// check if file is valid
-	if (header.sizeInBytes != sizeof(header)) {
+	// checksum over everything behind the header
+	if (!tmpMapping.open(tmpFilePath) || tmpMapping.size() != header.fileSize) {
+		tmpMapping.close();
+		filesystem::remove(tmpFilePath, errorCode);
 		return false;
 	}
+	header.checksum = calcChecksum(tmpMapping.data() + sizeof(header), tmpMapping.size() - sizeof(header));
+	tmpMapping.close();
+
+	// header
+	header.magic			= fileMagic;
+	header.version			= fileVersion;
+	header.endianness		= endiannessMarker;
+	header.headerSize		= sizeof(fileHeaderStruct);
+	header.layerStructSize	= sizeof(layerStruct);
+	header.numSections		= numSections;
+	{
+		fstream fs(tmpFilePath, ios::binary | ios::in | ios::out);
+		fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		if (!fs) {
+			fs.close();
+			filesystem::remove(tmpFilePath, errorCode);
+			return false;
+		}
+	}
 
-	readVector(hFile, sa.layer);
-	readVector(hFile, sa.layerIndex);
-	readVector(hFile, sa.amountSituationsAB);
-	readVector(hFile, sa.amountSituationsCD);
-	readVector(hFile, sa.groupIndexAB);
-	readVector(hFile, sa.groupIndexCD);
-	readVector(hFile, sa.symmetryOperationCD);
-	readVector(hFile, sa.powerOfThree);
-	readVector(hFile, sa.symmetryTransformationTable);
-	readVector(hFile, sa.reverseSymOperation);
-	readVector(hFile, sa.concSymOperation);
-	readVector(hFile, sa.mOverN);
-	sa.resizeGroupStateMappingArray(sa.groupStateAB, nullptr, 				    numSquaresGroupA + numSquaresGroupB);
-	sa.resizeGroupStateMappingArray(sa.groupStateCD, &sa.amountSituationsCD, 	numSquaresGroupC + numSquaresGroupD);
-	readVector(hFile, sa.groupStateAB);
-	readVector(hFile, sa.groupStateCD);
+	// replace the old file, which fails if it is still mapped by another process on windows
+	filesystem::rename(tmpFilePath, filePath, errorCode);
+	if (errorCode) {
+		filesystem::remove(tmpFilePath, errorCode);
+		return false;
+	}
 	return true;
 }
 
+#pragma endregion
+
+#pragma region mappedFile
+
 //-----------------------------------------------------------------------------
-// Name: writeToFile()
-// Desc: Writes the precalculated variables to the file preCalculatedVars.dat
+// Name: ~mappedFile()
+// Desc: destructor
 //-----------------------------------------------------------------------------
-bool stateAddressing::cacheFile::writeToFile()
+stateAddressing::mappedFile::~mappedFile()
+{
+	close();
+}
+
+//-----------------------------------------------------------------------------
+// Name: open()
+// Desc: Maps the whole file read-only into memory. Returns false if the file does not exist or is empty.
+//-----------------------------------------------------------------------------
+bool stateAddressing::mappedFile::open(const std::filesystem::path& filePath)
 {
+	close();
+
+#ifdef _WIN32
 	// locals
-	DWORD 			dwBytesWritten	= 0;
+	LARGE_INTEGER	fileSize;
+	HANDLE			hFile		= CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	HANDLE			hMapping	= NULL;
 
-	// check if file is valid
-	if (hFile == INVALID_HANDLE_VALUE || hFile == NULL) {
+	if (hFile == INVALID_HANDLE_VALUE) {
 		return false;
 	}
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(hFile);
+		return false;
+	}
+	hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping != NULL) {
+		view = static_cast<const unsigned char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+		CloseHandle(hMapping);
+	}
+	CloseHandle(hFile);
+	if (view == nullptr) {
+		return false;
+	}
+	numBytes = static_cast<size_t>(fileSize.QuadPart);
+#else
+	// locals
+	struct stat		fileStat;
+	int				fd			= ::open(filePath.c_str(), O_RDONLY);
 
-	// write vars into file
-	header.sizeInBytes = sizeof(header);
-
-	WriteFile(hFile, &header, header.sizeInBytes, &dwBytesWritten, NULL);
-	writeVector(hFile, sa.layer);
-	writeVector(hFile, sa.layerIndex);
-	writeVector(hFile, sa.amountSituationsAB);
-	writeVector(hFile, sa.amountSituationsCD);
-	writeVector(hFile, sa.groupIndexAB);
-	writeVector(hFile, sa.groupIndexCD);
-	writeVector(hFile, sa.symmetryOperationCD);
-	writeVector(hFile, sa.powerOfThree);
-	writeVector(hFile, sa.symmetryTransformationTable);
-	writeVector(hFile, sa.reverseSymOperation);
-	writeVector(hFile, sa.concSymOperation);
-	writeVector(hFile, sa.mOverN);
-	writeVector(hFile, sa.groupStateAB);
-	writeVector(hFile, sa.groupStateCD);
+	if (fd < 0) {
+		return false;
+	}
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	view 		= static_cast<const unsigned char*>(mapping);
+	numBytes 	= static_cast<size_t>(fileStat.st_size);
+#endif
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Name: close()
+// Desc: Unmaps the file. Pointers into the mapped memory become invalid.
+//-----------------------------------------------------------------------------
+void stateAddressing::mappedFile::close()
+{
+	if (view == nullptr) return;
+#ifdef _WIN32
+	UnmapViewOfFile(view);
+#else
+	munmap(const_cast<unsigned char*>(view), numBytes);
+#endif
+	view 		= nullptr;
+	numBytes 	= 0;
+}
+
 #pragma endregion
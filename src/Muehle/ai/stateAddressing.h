@@ -12,9 +12,16 @@
 #include <sstream>
 #include <filesystem>
 #include <limits>
+#include <fstream>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
 // win api
-#include <windows.h>
-#include <Shlwapi.h>
+#ifdef _WIN32
+	#include <windows.h>
+	#include <Shlwapi.h>
+#endif
 
 #include "../fieldStruct.h"
 
@@ -38,6 +45,7 @@ class stateAddressing
 friend class StateAddressingTest_internal_variables_Test;
 friend class StateAddressingTest_internal_functions_Test;
 friend class StateAddressingTest_totalNumMissingStones_Test;
+friend class StateAddressingTest_test_tableFree_rankingEngine_Test;
 
 public:
 	using groupStateNumber 	= unsigned int;		// number of a state within a group (without considering symmetry and the amount of white/black stones)
@@ -45,9 +53,16 @@ public:
 	using numWhiteStones 	= unsigned int;		// number of white stones
 	using numBlackStones 	= unsigned int;		// number of black stones
 	using symOperationId 	= unsigned int;		// number of a symmetry operation
+	using packedSymOperationId = std::uint8_t;	// number of a symmetry operation, as stored in the large table symmetryOperationCD
 	using subLayerId 		= unsigned int;		// number of a sublayer within a layer
 	using layerId  			= unsigned int;		// number of a layer
-	using stateId 			= unsigned int;		// number of a state within a layer
+#ifdef MUEHLE_STATE_ID_64
+	using stateId 			= std::uint64_t;	// number of a state within a layer
+#else
+	using stateId 			= unsigned int;		// number of a state within a layer. define MUEHLE_STATE_ID_64, if a layer exceeds 2^32 states.
+#endif
+
+	static_assert(std::is_unsigned_v<stateId> && sizeof(stateId) <= sizeof(std::uint64_t), "stateId must be an unsigned integer of up to 64 bit");
 
 	// The number of layers is calculated as follows:
 	// - 10 x 10 since each color can range from 0 to 9 stones
@@ -57,6 +72,7 @@ public:
 	static const unsigned int 			LAYER_INDEX_MOVING_PHASE		= 0;	
 	static const unsigned int 			LAYER_INDEX_SETTING_PHASE		= 1;
 	static constexpr unsigned int 		NOT_INDEXED						= 0xFFFFFFFFu;		// a constant that is used to indicate that a layer is not indexed
+	static constexpr stateId 			INVALID_STATE_NUMBER			= std::numeric_limits<stateId>::max();	// a state number, which does not address any state
 	static const unsigned int 			NUM_STONES_PER_PLAYER			= 9;
 
 	// Symmetry Operations
@@ -78,6 +94,13 @@ public:
 	static constexpr symOperationId		SO_INV_MIR_DIAG_2				= 15;
 	static constexpr symOperationId		NUM_SYM_OPERATIONS				= 16;
 
+	// way of determining the group index and the symmetry operation of group C&D. both yield the same state numbers.
+	enum class rankingEngine
+	{
+		lookupTables,			// look up groupIndexCD and symmetryOperationCD, holding an entry for each of the 3^16 states of group C&D
+		tableFree,				// compare the symmetric states of group C&D and search the original one within groupStateCD, so that only a few MB are needed
+	};
+
 private:	
 	static constexpr unsigned int 		numSquaresGroupA				= 4;			// number of stonefields in group A
 	static constexpr unsigned int 		numSquaresGroupB				= 4;			// ''
@@ -96,6 +119,9 @@ private:
 	static const unsigned int 			MAX_NUM_SITUATIONS_C			= 81*81;		// 3^numSquaresGroupC;
 	static const unsigned int 			MAX_NUM_SITUATIONS_D			= 81*81;		// 3^numSquaresGroupD;
 
+	// the groups and symmetry operations are defined for the board of nine men's morris
+	static_assert(std::is_same_v<fieldStruct::topology, nineMensMorris>, "stateAddressing only supports the board of nine men's morris");
+
 	// define the four groups	
 	static constexpr unsigned int 		squareIndexGroupA[] 			= {  3,  5, 20, 18 };
 	static constexpr unsigned int 		squareIndexGroupB[] 			= {  4, 13, 19, 10 };
@@ -110,6 +136,42 @@ private:
 					GROUP_A,				GROUP_B,				GROUP_A,
 		GROUP_C,							GROUP_D,							GROUP_C
 	};  
+	static constexpr bitBoard			squaresOfGroupCD				= []() {
+		bitBoard squares = 0;
+		for (auto pos : squareIndexGroupC) squares |= fieldStruct::squareMask(pos);
+		for (auto pos : squareIndexGroupD) squares |= fieldStruct::squareMask(pos);
+		return squares;
+	}();
+	static constexpr std::array<groupStateNumber, fieldStruct::size> squareWeightCD = []() {	// [fieldPos] -> 3^i of the square within the group state number of group C&D, or 0
+		std::array<groupStateNumber, fieldStruct::size> weights{};
+		groupStateNumber weight = 1;
+		for (unsigned int j = numSquaresGroupD; j-- > 0; weight *= 3) weights[squareIndexGroupD[j]] = weight;
+		for (unsigned int j = numSquaresGroupC; j-- > 0; weight *= 3) weights[squareIndexGroupC[j]] = weight;
+		return weights;
+	}();
+	static constexpr std::array<groupStateNumber, fieldStruct::size> squareWeightAB = []() {	// '' group A&B
+		std::array<groupStateNumber, fieldStruct::size> weights{};
+		groupStateNumber weight = 1;
+		for (unsigned int j = numSquaresGroupB; j-- > 0; weight *= 3) weights[squareIndexGroupB[j]] = weight;
+		for (unsigned int j = numSquaresGroupA; j-- > 0; weight *= 3) weights[squareIndexGroupA[j]] = weight;
+		return weights;
+	}();
+
+	// squares occupied by white and black stones for a group state number, see bitBoardsOfGroupAB etc.
+	struct groupBitBoardsStruct
+	{
+		bitBoard				white							= 0;		// squares with fieldStruct::playerWhite, being the current player
+		bitBoard				black							= 0;		// squares with fieldStruct::playerBlack
+	};
+	static const std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_A * MAX_NUM_SITUATIONS_B>	bitBoardsOfGroupAB;		// [stateAB]
+	static const std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_D>							bitBoardsOfLowDigitsCD;	// [stateCD % MAX_NUM_SITUATIONS_D]
+	static const std::array<groupBitBoardsStruct, MAX_NUM_SITUATIONS_C>							bitBoardsOfHighDigitsCD;// [stateCD / MAX_NUM_SITUATIONS_D]
+	static groupBitBoardsStruct	getGroupBitBoards				(const std::array<groupStateNumber, fieldStruct::size>& squareWeights, groupStateNumber state);
+
+	// a symmetry operation permutes the squares of a bit board, which is done byte by byte with a lookup table
+	static constexpr unsigned int		numBytesPerBitBoard				= (fieldStruct::size + 7) / 8;
+	using symmetryPermutationArray		= std::array<std::array<std::array<bitBoard, 256>, numBytesPerBitBoard>, NUM_SYM_OPERATIONS>;
+	using symmetricStateOfByteArray		= std::array<std::array<std::array<groupStateNumber, 256>, numBytesPerBitBoard>, NUM_SYM_OPERATIONS>;
 
 	#pragma region Symmetry Operations
     static constexpr unsigned int soTableTurnLeft[] = {        
@@ -276,8 +338,8 @@ private:
 	// structs
     struct subLayerStruct																											// each layer is devided into sublayers, based on the number of white/black stones in group C and D
     {   												
-        groupIndex 			minIndex;																								// index of the first state of this sublayer in the database
-        groupIndex 			maxIndex;																								// index of the last  state of this sublayer in the database
+        stateId 			minIndex;																								// index of the first state of this sublayer in the database
+        stateId 			maxIndex;																								// index of the last  state of this sublayer in the database
         numWhiteStones 		numWhiteStonesGroupCD;																					// number of white stones in group C and D
 		numBlackStones 		numBlackStonesGroupCD;																					// number of black stones in group C and D
         numWhiteStones 		numWhiteStonesGroupAB;																					// number of white stones in group A and B
@@ -293,7 +355,7 @@ private:
         subLayerId			subLayerIndexCD[NUM_STONES_PER_PLAYER+1][NUM_STONES_PER_PLAYER+1];										// mapping [number of white stones in group CD][number of black stones in group CD] to index within subLayer[]
         subLayerStruct		subLayer[MAX_NUM_SUB_LAYERS];																			// sublayers
 
-        unsigned int 		getStateNumberWithInSubLayer		(stateId stateNumber, bool settingPhase) const;
+        stateId 			getStateNumberWithInSubLayer		(stateId stateNumber, bool settingPhase) const;
         void 				getNumGroupStonesByStateNumber		(stateId stateNumber, bool settingPhase, numWhiteStones &numWhiteStonesGroupAB, numBlackStones &numBlackStonesGroupAB, numWhiteStones &numWhiteStonesGroupCD, numBlackStones &numBlackStonesGroupCD) const;
     };
     
@@ -322,85 +384,142 @@ private:
 		vec.resize(x, vector2D<T>(y, vector1D<T>(z, value)));
 	}
 
-	// Since the calculation of the variables takes some time, they are cached in the file preCalcedVars.dat
+	// table with one dimension, whose entries are either owned by the table or lie in place within the memory mapped cache file
+	template<typename T>
+	class table1D
+	{
+	private:
+		vector1D<T>				owned;							// entries, if the table has been calculated
+		T*						entries							= nullptr;	// points either to 'owned' or into the mapped file, which is read-only
+		size_t					numEntries						= 0;		// number of entries
+
+	public:
+								table1D							() = default;
+								table1D							(const table1D&) = delete;
+		table1D&				operator=						(const table1D&) = delete;
+
+		void					assign							(size_t size, T value)			{ owned.assign(size, value); entries = owned.data(); numEntries = size; }
+		void					map								(const T* mapped, size_t size)	{ owned = vector1D<T>{}; entries = const_cast<T*>(mapped); numEntries = size; }
+		void					clear							()								{ owned = vector1D<T>{}; entries = nullptr; numEntries = 0; }
+		T&						operator[]						(size_t index)					{ return entries[index]; }
+		const T&				operator[]						(size_t index) const			{ return entries[index]; }
+		const T*				data							() const						{ return entries; }
+		size_t					size							() const						{ return numEntries; }
+	};
+
+	// group states of all numbers of white and black stones, lying one after another in a single array
+	struct groupStateTable
+	{
+		vector1D<unsigned int>		offset;							// mapping [number of white stones * (NUM_STONES_PER_PLAYER+1) + number of black stones] to the position of the first state. the last entry is the total number of states.
+		vector1D<groupStateNumber>	state;							// mapping [offset + groupIndex] to groupStateNumber
+
+		groupStateNumber&			operator()						(numWhiteStones nws, numBlackStones nbs, groupIndex index)			{ return state[offset[nws * (NUM_STONES_PER_PLAYER+1) + nbs] + index]; }
+		groupStateNumber			operator()						(numWhiteStones nws, numBlackStones nbs, groupIndex index) const	{ return state[offset[nws * (NUM_STONES_PER_PLAYER+1) + nbs] + index]; }
+	};
+
+	// read-only view of a whole file, which is mapped into memory
+	class mappedFile
+	{
+	private:
+		const unsigned char*	view							= nullptr;	// first byte of the file
+		size_t					numBytes						= 0;		// size of the file
+
+	public:
+								mappedFile						() = default;
+								mappedFile						(const mappedFile&) = delete;
+		mappedFile&				operator=						(const mappedFile&) = delete;
+								~mappedFile						();
+
+		bool					open							(const std::filesystem::path& filePath);
+		void					close							();
+		const unsigned char*	data							() const { return view; }
+		size_t					size							() const { return numBytes; }
+	};
+
+	// Since the calculation of the variables takes some time, they are cached in the file preCalculatedVars.dat.
+	// The file consists of a header, a table of sections and one section per variable, each starting at a multiple of 'sectionAlignment'.
+	// A file of another version, with another byte order, a wrong size or a wrong checksum is ignored and replaced.
+	// The file is mapped into memory, so that the large tables groupIndexCD and symmetryOperationCD are used in place without copying.
+	// With rankingEngine::tableFree these two sections are skipped, and the file is unmapped after copying the other ones.
 	class cacheFile
 	{
 	private:
+		static constexpr std::uint64_t	fileMagic				= 0x4153454C4845554Dull;	// "MUEHLESA" in little endian
+		static constexpr std::uint32_t	fileVersion				= 3;						// increment on each change of the format or of the cached variables
+		static constexpr std::uint32_t	endiannessMarker		= 0x01020304;				// read as another value on a machine with a different byte order
+		static constexpr std::uint64_t	sectionAlignment		= 64;						// alignment of each section within the file
+		static constexpr std::uint32_t	numSections				= 14;						// number of cached variables
+
 		struct fileHeaderStruct
 		{
-			unsigned int	sizeInBytes						= 0;
+			std::uint64_t		magic							= 0;		// identifies the file type
+			std::uint32_t		version							= 0;		// see fileVersion
+			std::uint32_t		endianness						= 0;		// see endiannessMarker
+			std::uint32_t		headerSize						= 0;		// sizeof(fileHeaderStruct)
+			std::uint32_t		layerStructSize					= 0;		// sizeof(layerStruct), which might differ between compilers
+			std::uint32_t		numSections						= 0;		// number of entries in the section table behind the header
+			std::uint32_t		reserved						= 0;		// zero
+			std::uint64_t		fileSize						= 0;		// size of the whole file, so that a truncated file is detected
+			std::uint64_t		checksum						= 0;		// checksum of everything behind the header
 		};
 
-		template <typename T>
-		static bool writeVector(HANDLE hFile, const vector1D<T>& vec)
+		struct sectionStruct
 		{
-			DWORD dwBytesWritten = 0;
-			BOOL result = WriteFile(hFile, vec.data(), sizeof(T) * vec.size(), &dwBytesWritten, NULL);
-			return result && dwBytesWritten == sizeof(T) * vec.size();
-		}
+			std::uint64_t		offset							= 0;		// position of the section within the file
+			std::uint64_t		sizeInBytes						= 0;		// size of the section
+		};
+
+		// size of the variables in bytes
+		template <typename T> static size_t getNumBytes(const vector1D<T>& vec)	{ return sizeof(T) * vec.size(); }
+		template <typename T> static size_t getNumBytes(const vector2D<T>& vec)	{ size_t numBytes = 0; for (const auto& subVec : vec) numBytes += getNumBytes(subVec); return numBytes; }
+		template <typename T> static size_t getNumBytes(const vector3D<T>& vec)	{ size_t numBytes = 0; for (const auto& subVec : vec) numBytes += getNumBytes(subVec); return numBytes; }
+		template <typename T> static size_t getNumBytes(const table1D<T>& vec)	{ return sizeof(T) * vec.size(); }
+
+		// write the variables one after another
+		template <typename T> static void writeVector(std::ostream& os, const vector1D<T>& vec)	{ os.write(reinterpret_cast<const char*>(vec.data()), getNumBytes(vec)); }
+		template <typename T> static void writeVector(std::ostream& os, const vector2D<T>& vec)	{ for (const auto& subVec : vec) writeVector(os, subVec); }
+		template <typename T> static void writeVector(std::ostream& os, const vector3D<T>& vec)	{ for (const auto& subVec : vec) writeVector(os, subVec); }
+		template <typename T> static void writeVector(std::ostream& os, const table1D<T>& vec)	{ os.write(reinterpret_cast<const char*>(vec.data()), getNumBytes(vec)); }
+
+		// copy the variables from the mapped file, returning the position behind them
+		template <typename T> static const unsigned char* readVector(const unsigned char* src, vector1D<T>& vec)	{ std::memcpy(vec.data(), src, getNumBytes(vec)); return src + getNumBytes(vec); }
+		template <typename T> static const unsigned char* readVector(const unsigned char* src, vector2D<T>& vec)	{ for (auto& subVec : vec) src = readVector(src, subVec); return src; }
+		template <typename T> static const unsigned char* readVector(const unsigned char* src, vector3D<T>& vec)	{ for (auto& subVec : vec) src = readVector(src, subVec); return src; }
 
 		template <typename T>
-		static bool writeVector(HANDLE hFile, const vector2D<T>& vec)
+		void writeSection(std::ostream& os, std::vector<sectionStruct>& sections, const T& vec)
 		{
-			for (const auto& subVec : vec) {
-				DWORD dwBytesWritten = 0;
-				BOOL result = WriteFile(hFile, subVec.data(), sizeof(T) * subVec.size(), &dwBytesWritten, NULL);
-				if (!result || dwBytesWritten != sizeof(T) * subVec.size()) {
-					return false;
-				}
-			}
-			return true;
+			static const char padding[sectionAlignment] = {};
+			std::uint64_t offset = static_cast<std::uint64_t>(os.tellp());
+			os.write(padding, (sectionAlignment - offset % sectionAlignment) % sectionAlignment);
+			sections.push_back({static_cast<std::uint64_t>(os.tellp()), getNumBytes(vec)});
+			writeVector(os, vec);
 		}
-		
+
 		template <typename T>
-		static bool writeVector(HANDLE hFile, const vector3D<T>& vec)
+		bool readSection(unsigned int sectionNumber, T& vec) const
 		{
-			for (const auto& subVec2D : vec) {
-				for (const auto& subVec : subVec2D) {
-					DWORD dwBytesWritten = 0;
-					BOOL result = WriteFile(hFile, subVec.data(), sizeof(T) * subVec.size(), &dwBytesWritten, NULL);
-					if (!result || dwBytesWritten != sizeof(T) * subVec.size()) {
-						return false;
-					}
-				}
-			}
+			const sectionStruct& section = getSection(sectionNumber);
+			if (section.sizeInBytes != getNumBytes(vec)) return false;
+			readVector(sa.cacheMapping.data() + section.offset, vec);
 			return true;
 		}
 
 		template <typename T>
-		static void readVector(HANDLE hFile, vector1D<T>& vec)
-		{
-			DWORD dwBytesRead = 0;
-			ReadFile(hFile, vec.data(), sizeof(T) * vec.size(), &dwBytesRead, NULL);
-		}
-		
-		template <typename T>
-		static void readVector(HANDLE hFile, vector2D<T>& vec)
-		{
-			DWORD dwBytesRead = 0;
-			for (auto& subVec : vec) {
-				ReadFile(hFile, subVec.data(), sizeof(T) * subVec.size(), &dwBytesRead, NULL);
-			}
-		}
-		
-		template <typename T>
-		static bool readVector(HANDLE hFile, vector3D<T>& vec)
+		bool mapSection(unsigned int sectionNumber, table1D<T>& vec, size_t numEntries) const
 		{
-			DWORD dwBytesRead = 0;
-			for (auto& subVec2D : vec) {
-				for (auto& subVec : subVec2D) {
-					BOOL result = ReadFile(hFile, subVec.data(), sizeof(T) * subVec.size(), &dwBytesRead, NULL);
-					if (!result || dwBytesRead != sizeof(T) * subVec.size())
-						return false;
-				}
-			}
+			const sectionStruct& section = getSection(sectionNumber);
+			if (section.sizeInBytes != sizeof(T) * numEntries) return false;
+			vec.map(reinterpret_cast<const T*>(sa.cacheMapping.data() + section.offset), numEntries);
 			return true;
 		}
 
+		const sectionStruct&	getSection						(unsigned int sectionNumber) const;
+		bool					isMappedFileValid				() const;
+		static std::uint64_t	calcChecksum					(const unsigned char* data, size_t numBytes);
+
 		// internal variables
-		HANDLE 					hFile							= INVALID_HANDLE_VALUE;
-		std::wstring			filePath;
-		fileHeaderStruct		header;
+		std::filesystem::path	filePath;
 		stateAddressing&		sa;
 			
 	public:	
@@ -423,6 +542,8 @@ private:
 	void 						countStonesInGroup				(const fieldStruct::core& field, numWhiteStones& numWhiteStonesGroupAB, numBlackStones& numBlackStonesGroupAB, numWhiteStones& numWhiteStonesGroupCD, numBlackStones& numBlackStonesGroupCD) const;
 	void 						countStonesInGroupCD			(const fieldStruct::core& field, numWhiteStones& numWhiteStonesGroupCD, numBlackStones& numBlackStonesGroupCD) const;
 	bool 						addTotalNumMissingStonesOffset	(stateId & stateNumber, const fieldStruct::core& field) const;
+	bool 						addTotalNumMissingStonesOffset	(stateId & stateNumber, unsigned int nsm_curPlayer, unsigned int nsm_oppPlayer, numWhiteStones numStonesCurPlayer, numBlackStones numStonesOppPlayer) const;
+	void						calcStateNumber					(layerId layerNum, stateId& stateNumber, symOperationId& symOp, const fieldStruct::fieldArray& myField, numWhiteStones wCD, numBlackStones bCD) const;
 	bool 						isSettingPhase					(layerId layerNum) const;
 	static unsigned int 		getMaxTotalNumMissingStones		(numWhiteStones amountWhiteStones, numBlackStones amountBlackStones);
     unsigned int 				getTotalNumMissingStones		(stateId stateNumber, bool settingPhase, numWhiteStones amountWhiteStones, numBlackStones amountBlackStones) const;
@@ -432,6 +553,7 @@ private:
 	void 						init_powerOfThree				();
 	void 						init_symOperationMappings		();
 	void 						init_concSymOperation			();
+	void 						init_symmetryPermutationTable	();
     void 						init_group_AB					();
     void 						init_group_CD					();
 	void 						initLayerRegardingSettingPhase	();
@@ -442,41 +564,108 @@ private:
     static inline void 			calcGroupStateNumberBasedOnField(const fieldStruct::fieldArray &field, unsigned int numSquaresInGroup, groupStateNumber &stateNumber, const unsigned int *squareIndexGroup, unsigned int groupOrder, const vector1D<unsigned int>& powerOfThree);
 	void 						calcGroupStateNumberAB			(const fieldStruct::fieldArray &field, groupStateNumber &stateNumberAB) const;
 	void 						calcGroupStateNumberCD			(const fieldStruct::fieldArray &field, groupStateNumber &stateNumberCD) const;
-	void 						resizeGroupStateMappingArray	(vector3D<unsigned int> &originalState, const vector2D<unsigned int> *pAmountSituations, unsigned int numSquaresInGroup) const;
+	void 						resizeGroupStateMappingArray	(groupStateTable &groupState, const vector2D<groupIndex> *pAmountSituations, unsigned int numSquaresInGroup) const;
+	static void					runInParallel					(unsigned int numChunks, const std::function<void(unsigned int)>& processChunk);
+	bitBoard					applySymmetryTransfToBitBoard	(symOperationId symmetryOperation, bitBoard squares) const;
+	void						findOriginalStateCD				(bitBoard whiteStones, bitBoard blackStones, numWhiteStones wCD, numBlackStones bCD, groupIndex& indexCD, symOperationId& symOp) const;
+	unsigned int				getSymmetricImages				(const fieldStruct::packedCore& field, std::array<fieldStruct::packedCore, NUM_SYM_OPERATIONS>& images, std::array<symOperationId, NUM_SYM_OPERATIONS>& symOpOfImage, std::array<unsigned int, NUM_SYM_OPERATIONS>& imageOfSymOp) const;
 
 	// internal variables
+	rankingEngine				engine;							// see rankingEngine. groupIndexCD and symmetryOperationCD are empty, if they are not looked up.
 	vector1D<groupIndex> 		groupIndexAB;					// mapping [groupStateNumber] to groupIndex within group AB
-	vector1D<groupIndex> 		groupIndexCD;					// mapping [groupStateNumber] to groupIndex within group CD
-	vector3D<groupStateNumber> 	groupStateAB;					// mapping [number of white stones][number of black stones][groupIndex] to groupStateNumber with in group AB
-	vector3D<groupStateNumber> 	groupStateCD;					// mapping [number of white stones][number of black stones][groupIndex] to groupStateNumber with in group CD
+	table1D<groupIndex> 		groupIndexCD;					// mapping [groupStateNumber] to groupIndex within group CD
+	groupStateTable 			groupStateAB;					// mapping (number of white stones, number of black stones, groupIndex) to groupStateNumber with in group AB
+	groupStateTable 			groupStateCD;					// mapping (number of white stones, number of black stones, groupIndex) to groupStateNumber with in group CD
 	vector2D<groupIndex> 		amountSituationsAB;				// mapping [number of white stones][number of black stones] to number of situations for group A and B (considering symmetry operations). this corresponds to the maximum groupIndex within group AB
 	vector2D<groupIndex> 		amountSituationsCD;				// mapping [number of white stones][number of black stones] to number of situations for group C and D (considering symmetry operations). this corresponds to the maximum groupIndex within group CD
-	vector1D<symOperationId> 	symmetryOperationCD;			// index of symmetry operation used to get from the symmetric state to one listed in groupIndexCD
+	table1D<packedSymOperationId> symmetryOperationCD;			// index of symmetry operation used to get from the symmetric state to one listed in groupIndexCD
 	vector1D<unsigned int> 		powerOfThree;					// 3^0, 3^1, 3^2, ...
 	vector2D<unsigned int> 		mOverN;							// mapping [m][n] to m over n
 	vector1D<symOperationId> 	reverseSymOperation;			// index of the reverse symmetry operation: [symmetry operation] -> reverse symmetry operation
 	vector2D<unsigned int> 		symmetryTransformationTable;	// matrix used for application of the symmetry operations to the field: [symmetry operation][field position]
+	symmetryPermutationArray	symmetryPermutationTable;		// squares of the symmetric bit board: [symmetry operation][byte of the bit board][value of the byte] -> bit board
+	symmetricStateOfByteArray	symmetricStateOfByteCD;			// sum of squareWeightCD of the squares of symmetryPermutationTable, being the contribution of one byte of a player's stones to the symmetric group state number of group C&D
 	vector3D<unsigned int> 		layerIndex;						// mapping [moving/setting phase][number of white stones][number of black stones] to layer index
 	vector1D<layerStruct> 		layer;							// information about the layers
+	mappedFile					cacheMapping;					// cache file, which contains groupIndexCD and symmetryOperationCD if they have not been calculated
 	
 public:
+	// result of getStateNumbers()
+	struct stateNumberStruct
+	{
+		layerId					layerNum						= NOT_INDEXED;		// layer of the state, or NOT_INDEXED if the state cannot be addressed
+		stateId					stateNumber						= INVALID_STATE_NUMBER;	// state number within the layer
+		symOperationId			symOp							= SO_DO_NOTHING;	// symmetry operation, which turns the state into the one represented by the state number
+	};
+	static constexpr unsigned int stateNumberBatchSize			= 8;				// number of states, whose table lookups are interleaved by getStateNumbers()
+
+	// Iterates over the states of a layer in ascending order of the state number. Each step yields the same field as getFieldByStateNumber().
+	// Instead of unranking each state from scratch, the missing stones, the index within group C&D, the index within group A&B and the sublayer are counted up like digits,
+	// and only the squares being changed are updated.
+	class layerIterator
+	{
+	public:
+								layerIterator					(const stateAddressing& sa, layerId layerNum, playerId curPlayer, stateId firstState = 0, stateId endState = std::numeric_limits<stateId>::max());
+
+		bool					isEnd							() const	{ return stateNumber >= endState; }
+		void					next							();
+		stateId					getStateNumber					() const	{ return stateNumber; }
+		bool					isValid							() const	{ return valid; }			// return value of getFieldByStateNumber()
+		const fieldStruct&		getField						() const	{ return field; }
+
+	private:
+		const stateAddressing&	sa;
+		const layerId			layerNum;
+		const layerStruct&		curLayer;
+		const bool				settingPhase;
+		const unsigned int		maxTotalNumMissingStones;											// number of states differing only by the number of missing stones
+		const playerId			curPlayer;
+		const playerId			oppPlayer;
+		stateId					stateNumber						= 0;
+		stateId					endState						= 0;								// first state number not visited any more
+
+		// position of the current state
+		subLayerId				subLayerIndex					= 0;
+		groupIndex				indexAB							= 0;
+		groupIndex				indexCD							= 0;
+		unsigned int			totalNumMissingStones			= 0;
+
+		// squares of the current state
+		groupBitBoardsStruct	bitBoardsAB;														// stones of group A&B
+		groupBitBoardsStruct	bitBoards;															// stones of the current state
+		fieldStruct::fieldArray	myField;															// '', with the ids of curPlayer and oppPlayer
+		fieldStruct				field;
+		bool					valid							= false;
+
+		void					seek							(stateId firstState);
+		void					setGroupAB						();
+		void					setGroupCD						();
+		void					setSituation					();
+	};
+
 	vector2D<symOperationId> 	concSymOperation;				// symmetry operation, which is identical to applying those two concatenated symmetry operations: [symmetry operation 1][symmetry operation 2] -> resulting symmetry operation
 
     // constructor
-    							stateAddressing					(std::wstring const& directory);
+    							stateAddressing					(std::wstring const& directory, rankingEngine engine = rankingEngine::lookupTables);
 	
     // getter	
 	const layerStruct&			getLayer                        (layerId layerNum) const;
-    unsigned int            	getNumberOfKnotsInLayer         (layerId layerNum) const;
+	rankingEngine				getRankingEngine				() const;
+    stateId            		getNumberOfKnotsInLayer         (layerId layerNum) const;
     unsigned int 				getLayerNumber					(unsigned int numStonesOfCurPlayer, unsigned int numStonesOfOppPlayer, bool isSettingPhase) const;
     unsigned int 				getLayerNumber					(const fieldStruct::core& field) const;
+    unsigned int 				getLayerNumber					(const fieldStruct::packedCore& field) const;
     bool                    	getStateNumber                  (layerId layerNum, stateId& stateNumber, symOperationId& symOp, const fieldStruct::core& field) const;
+    bool                    	getStateNumber                  (layerId layerNum, stateId& stateNumber, symOperationId& symOp, const fieldStruct::packedCore& field) const;
+    bool                    	getStateNumbers                 (const fieldStruct::packedCore* fields, size_t numFields, stateNumberStruct* results) const;
+    bool                    	getStateNumbers                 (const std::vector<fieldStruct::packedCore>& fields, std::vector<stateNumberStruct>& results) const;
     bool 						getFieldByStateNumber			(layerId layerNum, stateId stateNumber, fieldStruct& field, playerId curPlayer) const;
 
     // symmetry functions	
 	bool						applySymmetryTransfToField  	(symOperationId symmetryOperationNumber, bool doInverseOperation, fieldStruct& field) const;
 	bool						applySymmetryTransfToField  	(symOperationId symmetryOperationNumber, bool doInverseOperation, fieldStruct::core& field) const;
     bool 						getStateNumbersOfSymmetricStates(const fieldStruct::core& field, std::array<stateId, stateAddressing::NUM_SYM_OPERATIONS>& stateNumbers) const;
+	unsigned int				getUniqueSymmetricStates		(const fieldStruct::packedCore& field, std::array<stateNumberStruct, stateAddressing::NUM_SYM_OPERATIONS>& symStates) const;
 	bool						isSymOperationInvariant         (symOperationId symmetryOperation, const fieldStruct::core& field) const;
 };
 
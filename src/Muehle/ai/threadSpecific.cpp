@@ -7,8 +7,6 @@
 
 #include "threadSpecific.h"
 
-#include <set>
-
 using namespace std;
 
 //-----------------------------------------------------------------------------
@@ -49,7 +47,20 @@ void threadVarsStruct::reset()
 //-----------------------------------------------------------------------------
 void threadVarsStruct::getPossibilities(vector<unsigned int> &possibilityIds) const
 {
-	field.getPossibilities(possibilityIds);
+	// locals
+	fieldStruct::possibilityArray	buffer;
+	unsigned int					numPossibilities = getPossibilities(buffer);
+
+	possibilityIds.assign(buffer.begin(), buffer.begin() + numPossibilities);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getPossibilities()
+// Desc: Writes the possible moves for the current situation into a fixed-capacity buffer and returns their number.
+//-----------------------------------------------------------------------------
+unsigned int threadVarsStruct::getPossibilities(fieldStruct::possibilityArray& possibilityIds) const
+{
+	return field.getPossibilities(possibilityIds);
 }
 
 //-----------------------------------------------------------------------------
@@ -61,12 +72,26 @@ miniMax::twoBit threadVarsStruct::getValueOfSituation() const
 	return shortValue;
 }
 
+//-----------------------------------------------------------------------------
+// Name: toMiniMaxStateNumber()
+// Desc: Converts a state number to the 32 bit state numbers of the miniMax library.
+//		 Returns false instead of truncating, if the state number does not fit.
+//-----------------------------------------------------------------------------
+bool threadVarsStruct::toMiniMaxStateNumber(stateAddressing::stateId stateNumber, unsigned int& miniMaxStateNumber)
+{
+	if (stateNumber > numeric_limits<unsigned int>::max()) {
+		return false;
+	}
+	miniMaxStateNumber = static_cast<unsigned int>(stateNumber);
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // Name: getLayerAndStateNumber()
 // Desc: Returns the symmetry operation, the layer number and the state number of the current situation.
 //		 Current player has white stones, the opponent the black ones.
 //-----------------------------------------------------------------------------
-void threadVarsStruct::getLayerAndStateNumber(unsigned int &layerNum, unsigned int &stateNumber, stateAddressing::symOperationId &symOp) const
+void threadVarsStruct::getLayerAndStateNumber(unsigned int &layerNum, stateAddressing::stateId &stateNumber, stateAddressing::symOperationId &symOp) const
 {
 	layerNum 	= getLayerNumber();
 	sa.getStateNumber(layerNum, stateNumber, symOp, field);
@@ -84,20 +109,27 @@ unsigned int threadVarsStruct::getLayerNumber() const
 //-----------------------------------------------------------------------------
 // Name: getSymStateNumWithDuplicates()
 // Desc: Returns the state number of the current situation for all symmetry operations. 
+//		 Returns no states, if a state number exceeds the range of the miniMax library.
 //-----------------------------------------------------------------------------
 void threadVarsStruct::getSymStateNumWithDuplicates(vector<miniMax::stateAdressStruct> &symStates) const
 {
 	// locals
 	unsigned int			symmetryOperation;
 	unsigned int			layerNum = getLayerNumber();
-	array<unsigned int, stateAddressing::NUM_SYM_OPERATIONS> stateNumbers;
+	unsigned int			stateNumber;
+	array<stateAddressing::stateId, stateAddressing::NUM_SYM_OPERATIONS> stateNumbers;
 				 
 	symStates.clear();
 
 	sa.getStateNumbersOfSymmetricStates(field, stateNumbers);
 
 	for (symmetryOperation = 0; symmetryOperation < stateAddressing::NUM_SYM_OPERATIONS; ++symmetryOperation) {
-		symStates.push_back(miniMax::stateAdressStruct{stateNumbers[symmetryOperation], (unsigned char) layerNum});
+		if (!toMiniMaxStateNumber(stateNumbers[symmetryOperation], stateNumber)) {
+			cout << "ERROR: State number exceeds the range of the miniMax library in getSymStateNumWithDuplicates()!" << endl;
+			symStates.clear();
+			return;
+		}
+		symStates.push_back(miniMax::stateAdressStruct{stateNumber, (unsigned char) layerNum});
 	}
 }
 
@@ -147,7 +179,7 @@ void threadVarsStruct::applySymOp(stateAddressing::symOperationId symmetryOperat
 //		 Current player has white stones, the opponent the black ones.
 //       Returns false if the field state is invalid.
 //-----------------------------------------------------------------------------
-bool threadVarsStruct::setSituation(unsigned int layerNum, unsigned int stateNumber)
+bool threadVarsStruct::setSituation(unsigned int layerNum, stateAddressing::stateId stateNumber)
 {
 	// locals
 	bool 				fieldIntegrityOK;
@@ -200,7 +232,7 @@ void threadVarsStruct::move(unsigned int idPossibility, void *&pBackup)
 	pBackup						= (void*) &oldState;
 	curSearchDepth++;
 
-	move.setId(idPossibility);
+	move = moveInfo::getMoveInfo(idPossibility);
 	field.move(move, oldState);
 
 	// when game has finished and it's the turn of the opponent, then the state is lost for him
@@ -265,61 +297,28 @@ void threadVarsStruct::printMoveInformation(unsigned int idPossibility) const
 // Name: storePredecessor()
 // Desc: Internal function for storing the predecessor state in the list of predecessors. 
 //-----------------------------------------------------------------------------
-bool threadVarsStruct::storePredecessor(const fieldStruct::core& predField, vector<miniMax::retroAnalysis::predVars>& predVars) const
+bool threadVarsStruct::storePredecessor(const fieldStruct::packedCore& predField, vector<miniMax::retroAnalysis::predVars>& predVars) const
 {
 	// locals
-	unsigned int						symmetryOperation, symmetryOperation2;
-	miniMax::retroAnalysis::predVars	newPredVar;
-	fieldStruct::core					symField;
-	stateAddressing::layerId			layerNumber = sa.getLayerNumber(predField);
-	stateAddressing::stateId			stateNumber;
+	miniMax::retroAnalysis::predVars												newPredVar;
+	array<stateAddressing::stateNumberStruct, stateAddressing::NUM_SYM_OPERATIONS>	symStates;
 
-	// Use unordered_set to track unique stateAdressStructs
-	std::set<miniMax::stateAdressStruct> seen;
-
-	if (!sa.getStateNumber(layerNumber, stateNumber, symmetryOperation, predField)) {
-		cout << "ERROR: getStateNumber() failed, when storing predecessor state!" << endl;
+	// the state of the predecessor itself and of each symmetric field, without duplicates
+	const unsigned int numSymStates = sa.getUniqueSymmetricStates(predField, symStates);
+	if (!numSymStates) {
+		cout << "ERROR: getUniqueSymmetricStates() failed, when storing predecessor state!" << endl;
 		return false;
 	}
 
-	// store current state, without any symmetry operation applied
-	newPredVar.predLayerNumber 		= layerNumber;
-	newPredVar.playerToMoveChanged	= true;
-	newPredVar.predStateNumber 		= stateNumber;
-	newPredVar.predSymOperation		= symmetryOperation;
-	predVars.push_back(newPredVar);
-	seen.insert(miniMax::stateAdressStruct{stateNumber, (unsigned char)layerNumber});
-
-	for (symmetryOperation = 0; symmetryOperation < stateAddressing::NUM_SYM_OPERATIONS; ++symmetryOperation) {
-
-		// TODO: Check if this is really correct. Shouldn't it be "if (symmetryOperation != SO_DO_NOTHING && sa.isSymOperationInvariant(...)) continue;"?
-		// only add if sym operation actually does something
-		if (!sa.isSymOperationInvariant(symmetryOperation, predField)) {
-			continue;
-		}
-
-		// copy field
-		symField = predField; 
-
-		// appy symmetry operation
-		sa.applySymmetryTransfToField(symmetryOperation, false, symField);
-
-		// store state number
-		if (!sa.getStateNumber(layerNumber, stateNumber, symmetryOperation2, symField)) {
-			cout << "ERROR: getStateNumber() failed, when storing predecessor state!" << endl;
+	for (unsigned int i = 0; i < numSymStates; i++) {
+		if (!toMiniMaxStateNumber(symStates[i].stateNumber, newPredVar.predStateNumber)) {
+			cout << "ERROR: State number exceeds the range of the miniMax library, when storing predecessor state!" << endl;
 			return false;
 		}
-
-		// there are now two symmetry operations: the one applied to the field and the one applied due to mapping to the state number
-		newPredVar.predStateNumber 	= stateNumber;
-		newPredVar.predSymOperation = sa.concSymOperation[symmetryOperation][symmetryOperation2];
-
-		// add only if not already in set
-		miniMax::stateAdressStruct key{stateNumber, (unsigned char)layerNumber};
-		if (seen.find(key) == seen.end()) {
-			predVars.push_back(newPredVar);
-			seen.insert(key);
-		}
+		newPredVar.predLayerNumber 		= symStates[i].layerNum;
+		newPredVar.playerToMoveChanged	= true;
+		newPredVar.predSymOperation		= symStates[i].symOp;
+		predVars.push_back(newPredVar);
 	}
 
 	return true;
@@ -34,27 +34,29 @@ private:
     char						padding[64];											            // Cache line padding to prevent false sharing in multithreaded contexts
     stateAddressing&	        sa;	                                                                // reference to the state addressing
     backupArray                 oldStates;						                                    // for undo()-function	
-    vector<fieldStruct::core>    predFields;                                                         // buffer for storing predecessors states
+    vector<fieldStruct::packedCore> predFields;                                                     // buffer for storing predecessors states
     fieldStruct			        field;							                                    // current game field [changed by move()]
     unsigned int		        curSearchDepth                  = 0;	                            // current level
     miniMax::twoBit		        shortValue                      = miniMax::SKV_VALUE_INVALID;		// value of the current situation
     
     // database functions   
-    bool				        storePredecessor				(const fieldStruct::core& predField, vector<miniMax::retroAnalysis::predVars>& predVars) const;
+    bool				        storePredecessor				(const fieldStruct::packedCore& predField, vector<miniMax::retroAnalysis::predVars>& predVars) const;
 
 public: 
     // constructor
                                 threadVarsStruct				(stateAddressing& sa);
                                 ~threadVarsStruct				();
     void                        reset		        			();  
+    static bool                 toMiniMaxStateNumber            (stateAddressing::stateId stateNumber, unsigned int& miniMaxStateNumber);
     
     // Assignment operator intentionally disabled to prevent copying of thread-specific resources.
     threadVarsStruct&           operator=                       (const threadVarsStruct& other) = delete;
 
     // getter (from miniMax::gameInterface)
     void					    getPossibilities				(vector<unsigned int>& possibilityIds) const;
+    unsigned int			    getPossibilities				(fieldStruct::possibilityArray& possibilityIds) const;
 	miniMax::twoBit 		    getValueOfSituation				() const;
-	void					    getLayerAndStateNumber			(unsigned int &layerNum, unsigned int &stateNumber, stateAddressing::symOperationId& symOp) const;
+	void					    getLayerAndStateNumber			(unsigned int &layerNum, stateAddressing::stateId &stateNumber, stateAddressing::symOperationId& symOp) const;
 	unsigned int			    getLayerNumber					() const;
 	void					    getSymStateNumWithDuplicates	(vector<miniMax::stateAdressStruct>& symStates) const;
     void					    getPredecessors             	(vector<miniMax::retroAnalysis::predVars>& predVars);
@@ -62,7 +64,7 @@ public:
 
 	// setter (from miniMax::gameInterface)
 	void					    applySymOp						(stateAddressing::symOperationId symmetryOperationNumber, bool doInverseOperation, bool playerToMoveChanged);
-	bool					    setSituation					(unsigned int layerNum, unsigned int stateNumber);
+	bool					    setSituation					(unsigned int layerNum, stateAddressing::stateId stateNumber);
     void                        setField                        (const fieldStruct& field);
 	void					    move							(unsigned int idPossibility, void* &pBackup);
 	void					    undo							(unsigned int idPossibility, void*  pBackup);
@@ -0,0 +1,225 @@
+/*********************************************************************\
+	boardTopology.h
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+\*********************************************************************/
+
+#ifndef BOARD_TOPOLOGY_H
+#define BOARD_TOPOLOGY_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/*** Types *********************************************************/
+using 							bitBoard								= std::uint32_t;		// set of squares, where bit i stands for square i
+
+/*** Topologies ******************************************************/
+
+// A topology describes the board of a morris variant at compile time:
+//  - numSquares:           number of squares
+//  - numStonesPerPlayer:   number of stones each player sets during the setting phase
+//  - maxMillsPerSquare:    maximum number of mills running through a single square
+//  - connections:          pairs of squares, between which a stone can be moved
+//  - mills:                lines of three squares forming a mill
+//  - layout:               drawing of the board used by print(), where each '#' is replaced by the stone on the next square
+// The squares are numbered row by row from the top left to the bottom right.
+
+// Six Men's Morris: two squares without diagonals
+//  0 ----- 1 ----- 2
+//  |       |       |
+//  |   3 - 4 - 5   |
+//  6 - 7       8 - 9
+//  |  10 -11 -12   |
+//  |       |       |
+// 13 -----14 -----15
+struct sixMensMorris
+{
+    static constexpr unsigned int   numSquares                      = 16;
+    static constexpr unsigned int   numStonesPerPlayer              =  6;
+    static constexpr unsigned int   maxMillsPerSquare               =  2;
+
+    static constexpr std::array<std::array<unsigned int, 2>, 20> connections = {{
+        { 0,  1}, { 1,  2}, { 3,  4}, { 4,  5}, { 6,  7}, { 8,  9}, {10, 11}, {11, 12}, {13, 14}, {14, 15},
+        { 0,  6}, { 6, 13}, { 3,  7}, { 7, 10}, { 1,  4}, {11, 14}, { 5,  8}, { 8, 12}, { 2,  9}, { 9, 15}
+    }};
+
+    static constexpr std::array<std::array<unsigned int, 3>, 8> mills = {{
+        { 0,  1,  2}, { 3,  4,  5}, {10, 11, 12}, {13, 14, 15},
+        { 0,  6, 13}, { 3,  7, 10}, { 5,  8, 12}, { 2,  9, 15}
+    }};
+
+    static constexpr const char*    layout =
+        "#-----#-----#\n"
+        "| #---#---# |\n"
+        "#-#       #-#\n"
+        "| #---#---# |\n"
+        "#-----#-----#";
+};
+
+// Nine Men's Morris: three squares without diagonals
+//  0 ----------- 1 ----------- 2
+//  |             |             |
+//  |    3 ------ 4 ------ 5    |
+//  |    |        |        |    |
+//  |    |    6 - 7 - 8    |    |
+//  |    |    |       |    |    |
+//  9 - 10 - 11      12 - 13 - 14
+//  |    |    |       |    |    |
+//  |    |   15 -16 - 17   |    |
+//  |    |        |        |    |
+//  |   18 ------19 ------ 20   |
+//  |             |             |
+// 21 -----------22 ----------- 23
+struct nineMensMorris
+{
+    static constexpr unsigned int   numSquares                      = 24;
+    static constexpr unsigned int   numStonesPerPlayer              =  9;
+    static constexpr unsigned int   maxMillsPerSquare               =  2;
+
+    static constexpr std::array<std::array<unsigned int, 2>, 32> connections = {{
+        { 0,  1}, { 1,  2}, { 3,  4}, { 4,  5}, { 6,  7}, { 7,  8}, { 9, 10}, {10, 11},
+        {12, 13}, {13, 14}, {15, 16}, {16, 17}, {18, 19}, {19, 20}, {21, 22}, {22, 23},
+        { 0,  9}, { 9, 21}, { 3, 10}, {10, 18}, { 6, 11}, {11, 15}, { 1,  4}, { 4,  7},
+        {16, 19}, {19, 22}, { 8, 12}, {12, 17}, { 5, 13}, {13, 20}, { 2, 14}, {14, 23}
+    }};
+
+    static constexpr std::array<std::array<unsigned int, 3>, 16> mills = {{
+        { 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}, { 9, 10, 11}, {12, 13, 14}, {15, 16, 17}, {18, 19, 20}, {21, 22, 23},
+        { 0,  9, 21}, { 3, 10, 18}, { 6, 11, 15}, { 1,  4,  7}, {16, 19, 22}, { 8, 12, 17}, { 5, 13, 20}, { 2, 14, 23}
+    }};
+
+    static constexpr const char*    layout =
+        "#-----#-----#\n"
+        "| #---#---# |\n"
+        "| | #-#-# | |\n"
+        "#-#-#   #-#-#\n"
+        "| | #-#-# | |\n"
+        "| #---#---# |\n"
+        "#-----#-----#";
+};
+
+// Twelve Men's Morris: the board of nine men's morris with the four diagonals at the corners
+struct twelveMensMorris
+{
+    static constexpr unsigned int   numSquares                      = 24;
+    static constexpr unsigned int   numStonesPerPlayer              = 12;
+    static constexpr unsigned int   maxMillsPerSquare               =  3;
+
+    static constexpr std::array<std::array<unsigned int, 2>, 40> connections = {{
+        { 0,  1}, { 1,  2}, { 3,  4}, { 4,  5}, { 6,  7}, { 7,  8}, { 9, 10}, {10, 11},
+        {12, 13}, {13, 14}, {15, 16}, {16, 17}, {18, 19}, {19, 20}, {21, 22}, {22, 23},
+        { 0,  9}, { 9, 21}, { 3, 10}, {10, 18}, { 6, 11}, {11, 15}, { 1,  4}, { 4,  7},
+        {16, 19}, {19, 22}, { 8, 12}, {12, 17}, { 5, 13}, {13, 20}, { 2, 14}, {14, 23},
+        { 0,  3}, { 3,  6}, { 2,  5}, { 5,  8}, {15, 18}, {18, 21}, {17, 20}, {20, 23}
+    }};
+
+    static constexpr std::array<std::array<unsigned int, 3>, 20> mills = {{
+        { 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}, { 9, 10, 11}, {12, 13, 14}, {15, 16, 17}, {18, 19, 20}, {21, 22, 23},
+        { 0,  9, 21}, { 3, 10, 18}, { 6, 11, 15}, { 1,  4,  7}, {16, 19, 22}, { 8, 12, 17}, { 5, 13, 20}, { 2, 14, 23},
+        { 0,  3,  6}, { 2,  5,  8}, {15, 18, 21}, {17, 20, 23}
+    }};
+
+    static constexpr const char*    layout =
+        "#-----#-----#\n"
+        "|\\    |    /|\n"
+        "| #---#---# |\n"
+        "| |\\  |  /| |\n"
+        "| | #-#-# | |\n"
+        "#-#-#   #-#-#\n"
+        "| | #-#-# | |\n"
+        "| |/  |  \\| |\n"
+        "| #---#---# |\n"
+        "|/    |    \\|\n"
+        "#-----#-----#";
+};
+
+/*** Classes *********************************************************/
+
+// bit board tables derived from a topology at compile time
+template <class topology>
+class topologyTables
+{
+public:
+    static constexpr unsigned int   size                            = topology::numSquares;
+    static constexpr unsigned int   numMills                        = static_cast<unsigned int>(topology::mills.size());
+    static constexpr unsigned int   maxMillsPerSquare               = topology::maxMillsPerSquare;
+
+    // a mask, which can never be occupied by a player, since it lies outside of the board.
+    // it fills the unused entries of 'millsOfSquare', so that they are never closed.
+    static constexpr bitBoard       unusedMill                      = bitBoard{1} << (std::numeric_limits<bitBoard>::digits - 1);
+    static_assert(size < std::numeric_limits<bitBoard>::digits, "the board must fit into a bitBoard, leaving one bit for 'unusedMill'");
+
+    // mask of the squares connected to each square
+    static constexpr std::array<bitBoard, size> adjacentSquares = []() {
+        std::array<bitBoard, size> adjacentSquares{};
+        for (const auto& connection : topology::connections) {
+            adjacentSquares[connection[0]] |= bitBoard{1} << connection[1];
+            adjacentSquares[connection[1]] |= bitBoard{1} << connection[0];
+        }
+        return adjacentSquares;
+    }();
+
+    // maximum number of squares connected to a single square
+    static constexpr unsigned int   maxNumAdjacentSquares           = []() {
+        unsigned int maxNumAdjacentSquares = 0;
+        for (bitBoard adjacent : adjacentSquares) {
+            unsigned int numAdjacentSquares = 0;
+            for (; adjacent; adjacent &= adjacent - 1) numAdjacentSquares++;
+            if (numAdjacentSquares > maxNumAdjacentSquares) maxNumAdjacentSquares = numAdjacentSquares;
+        }
+        return maxNumAdjacentSquares;
+    }();
+
+    // squares connected to each square, unused entries are set to 'size'.
+    // the connections listing the square first come before the ones listing it second, so that the order of the moves follows the list.
+    static constexpr std::array<std::array<unsigned int, maxNumAdjacentSquares>, size> connectedSquare = []() {
+        std::array<std::array<unsigned int, maxNumAdjacentSquares>, size> connectedSquare{};
+        std::array<unsigned int, size> numConnectedSquares{};
+        for (auto& connectedOfPos : connectedSquare) connectedOfPos.fill(size);
+        for (unsigned int side : {0, 1}) {
+            for (const auto& connection : topology::connections) {
+                connectedSquare[connection[side]][numConnectedSquares[connection[side]]++] = connection[1 - side];
+            }
+        }
+        return connectedSquare;
+    }();
+
+    // mask of every mill on the field
+    static constexpr std::array<bitBoard, numMills> mills = []() {
+        std::array<bitBoard, numMills> mills{};
+        for (unsigned int i = 0; i < numMills; i++) {
+            for (unsigned int pos : topology::mills[i]) mills[i] |= bitBoard{1} << pos;
+        }
+        return mills;
+    }();
+
+    // mask of the mills running through each square, unused entries are set to 'unusedMill'
+    static constexpr std::array<std::array<bitBoard, maxMillsPerSquare>, size> millsOfSquare = []() {
+        std::array<std::array<bitBoard, maxMillsPerSquare>, size> millsOfSquare{};
+        std::array<unsigned int, size> numMillsOfSquare{};
+        for (auto& millsOfPos : millsOfSquare) millsOfPos.fill(unusedMill);
+        for (bitBoard mill : mills) {
+            for (unsigned int pos = 0; pos < size; pos++) {
+                if (mill & (bitBoard{1} << pos)) millsOfSquare[pos][numMillsOfSquare[pos]++] = mill;
+            }
+        }
+        return millsOfSquare;
+    }();
+
+    // the other two squares of each mill running through a square in the order of the mill, unused entries are set to 'size'
+    static constexpr std::array<std::array<std::array<unsigned int, 2>, maxMillsPerSquare>, size> neighbour = []() {
+        std::array<std::array<std::array<unsigned int, 2>, maxMillsPerSquare>, size> neighbour{};
+        std::array<unsigned int, size> numMillsOfSquare{};
+        for (auto& neighbourOfPos : neighbour) neighbourOfPos.fill({size, size});
+        for (const auto& mill : topology::mills) {
+            for (unsigned int i = 0; i < 3; i++) {
+                neighbour[mill[i]][numMillsOfSquare[mill[i]]++] = {mill[i == 0 ? 1 : 0], mill[i == 2 ? 1 : 2]};
+            }
+        }
+        return neighbour;
+    }();
+};
+
+#endif
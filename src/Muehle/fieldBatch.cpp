@@ -0,0 +1,256 @@
+/*********************************************************************
+	fieldBatch.cpp
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+\*********************************************************************/
+
+#include "fieldBatch.h"
+#include <cassert>
+#include <bit>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+#pragma region fieldBatch
+
+#if defined(__AVX2__)
+const bool fieldBatch::simdEnabled = true;
+#else
+const bool fieldBatch::simdEnabled = false;
+#endif
+
+//-----------------------------------------------------------------------------
+// Name: set()
+// Desc: Copies the bit boards of a state into a lane. The output of the lane is valid after the next call of calculate().
+//-----------------------------------------------------------------------------
+void fieldBatch::set(unsigned int lane, const packedCore& state)
+{
+	assert(lane < numLanes);
+	curPlayerStones[lane]	= state.getCurPlayerStones();
+	oppPlayerStones[lane]	= state.getOppPlayerStones();
+	settingPhase[lane]		= state.inSettingPhase() ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Name: clear()
+// Desc: Sets all lanes to the empty field in the setting phase, which is useful to fill the unused lanes of the last batch.
+//-----------------------------------------------------------------------------
+void fieldBatch::clear()
+{
+	curPlayerStones.fill(0);
+	oppPlayerStones.fill(0);
+	settingPhase.fill(1);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getStonePartOfMill()
+// Desc: Returns the number of mills, of which the stone on the square is part of. Same as fieldStruct::isStonePartOfMill().
+//-----------------------------------------------------------------------------
+unsigned int fieldBatch::getStonePartOfMill(unsigned int lane, fieldPos pos) const
+{
+	assert(lane < numLanes && pos < size);
+	return ((stonesInMill[lane] >> pos) & 1) + ((stonesInTwoMills[lane] >> pos) & 1);
+}
+
+//-----------------------------------------------------------------------------
+// Name: calculate()
+// Desc: Calculates the output of all lanes.
+//-----------------------------------------------------------------------------
+void fieldBatch::calculate()
+{
+#if defined(__AVX2__)
+	calculateSimd();
+#else
+	calculateScalar();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Name: calculateScalar()
+// Desc: Calculates the output of all lanes one after another. Used if AVX2 is not available, and as reference for the SIMD implementation.
+//-----------------------------------------------------------------------------
+void fieldBatch::calculateScalar()
+{
+	for (unsigned int lane = 0; lane < numLanes; lane++) {
+		calculateLane(lane);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: calculateLane()
+// Desc: Calculates the output of a single lane, following calcStonePartOfMill(), calcNumPossibleMoves(), getPossStoneRemove() and getWinner() of fieldStruct.
+//-----------------------------------------------------------------------------
+void fieldBatch::calculateLane(unsigned int lane)
+{
+	// locals
+	const bitBoard		cur				= curPlayerStones[lane];
+	const bitBoard		opp				= oppPlayerStones[lane];
+	const bitBoard		freeSquares		= allSquares & ~(cur | opp);
+	const unsigned int	curNumStones	= std::popcount(cur);
+	const unsigned int	oppNumStones	= std::popcount(opp);
+	bitBoard			inMill			= 0;
+	bitBoard			inTwoMills		= 0;
+	unsigned int		curMills		= 0;
+	unsigned int		oppMills		= 0;
+
+	// closed mills
+	for (bitBoard mill : tables::mills) {
+		const bool curClosed = (cur & mill) == mill;
+		const bool oppClosed = (opp & mill) == mill;
+		if (!curClosed && !oppClosed) continue;
+		inTwoMills	|= inMill & mill;
+		inMill		|= mill;
+		curMills	+= curClosed;
+		oppMills	+= oppClosed;
+	}
+	stonesInMill[lane]				= inMill;
+	stonesInTwoMills[lane]			= inTwoMills;
+	curPlayerNumberOfMills[lane]	= curMills;
+	oppPlayerNumberOfMills[lane]	= oppMills;
+
+	// possible moves
+	auto numPossibleMoves = [&](bitBoard stones, unsigned int numStones) -> unsigned int {
+		if (settingPhase[lane])			return std::popcount(freeSquares);
+		if (canJump(numStones))			return numStones * std::popcount(freeSquares);
+		if (!movesAlongLines(numStones))	return 0;
+		unsigned int numMoves = 0;
+		for (bitBoard remaining = stones; remaining; ) {
+			numMoves += std::popcount(tables::adjacentSquares[popSquare(remaining)] & freeSquares);
+		}
+		return numMoves;
+	};
+	curPlayerNumPossibleMoves[lane]	= numPossibleMoves(cur, curNumStones);
+	oppPlayerNumPossibleMoves[lane]	= numPossibleMoves(opp, oppNumStones);
+
+	// removable stones of the opponent
+	const bool	oppHasOnlyMills	= oppMills > 0 && !(opp & ~inMill);
+	bitBoard	removable		= opp & ~inMill;
+	if (rules::removeFromMillIfOnlyMills && oppHasOnlyMills) {
+		removable |= opp & (rules::removeFromTwoMills ? allSquares : ~inTwoMills);
+	}
+	removableStones[lane] = removable;
+
+	// winner
+	if (settingPhase[lane])																	winner[lane] = gameNotFinished;
+	else if (oppNumStones < 3)																winner[lane] = curPlayerWon;
+	else if (curNumStones < 3)																winner[lane] = oppPlayerWon;
+	else if (!curPlayerNumPossibleMoves[lane] && movesAlongLines(curNumStones))				winner[lane] = oppPlayerWon;
+	else																					winner[lane] = gameNotFinished;
+}
+
+#if defined(__AVX2__)
+//-----------------------------------------------------------------------------
+// Name: popcount8x32()
+// Desc: Number of set bits in each 32 bit lane
+//-----------------------------------------------------------------------------
+static inline __m256i popcount8x32(__m256i x)
+{
+	const __m256i m1	= _mm256_set1_epi32(0x55555555);
+	const __m256i m2	= _mm256_set1_epi32(0x33333333);
+	const __m256i m4	= _mm256_set1_epi32(0x0F0F0F0F);
+	const __m256i h01	= _mm256_set1_epi32(0x01010101);
+
+	x = _mm256_sub_epi32(x, _mm256_and_si256(_mm256_srli_epi32(x, 1), m1));
+	x = _mm256_add_epi32(_mm256_and_si256(x, m2), _mm256_and_si256(_mm256_srli_epi32(x, 2), m2));
+	x = _mm256_and_si256(_mm256_add_epi32(x, _mm256_srli_epi32(x, 4)), m4);
+	return _mm256_srli_epi32(_mm256_mullo_epi32(x, h01), 24);
+}
+
+//-----------------------------------------------------------------------------
+// Name: calculateSimd()
+// Desc: Calculates the output of all lanes at once. The comparisons of AVX2 return all bits set for true, which is used as mask to select the results.
+//-----------------------------------------------------------------------------
+void fieldBatch::calculateSimd()
+{
+	// locals
+	const __m256i	zero			= _mm256_setzero_si256();
+	const __m256i	one				= _mm256_set1_epi32(1);
+	const __m256i	three			= _mm256_set1_epi32(3);
+	const __m256i	cur				= _mm256_load_si256(reinterpret_cast<const __m256i*>(curPlayerStones.data()));
+	const __m256i	opp				= _mm256_load_si256(reinterpret_cast<const __m256i*>(oppPlayerStones.data()));
+	const __m256i	setting			= _mm256_cmpeq_epi32(_mm256_load_si256(reinterpret_cast<const __m256i*>(settingPhase.data())), one);
+	const __m256i	freeSquares		= _mm256_andnot_si256(_mm256_or_si256(cur, opp), _mm256_set1_epi32(allSquares));
+	const __m256i	numFree			= popcount8x32(freeSquares);
+	const __m256i	curNumStones	= popcount8x32(cur);
+	const __m256i	oppNumStones	= popcount8x32(opp);
+	__m256i			inMill			= zero;
+	__m256i			inTwoMills		= zero;
+	__m256i			curMills		= zero;
+	__m256i			oppMills		= zero;
+
+	// closed mills, where subtracting a true mask counts one
+	for (bitBoard mill : tables::mills) {
+		const __m256i millMask	= _mm256_set1_epi32(mill);
+		const __m256i curClosed	= _mm256_cmpeq_epi32(_mm256_and_si256(cur, millMask), millMask);
+		const __m256i oppClosed	= _mm256_cmpeq_epi32(_mm256_and_si256(opp, millMask), millMask);
+		const __m256i squares	= _mm256_and_si256(_mm256_or_si256(curClosed, oppClosed), millMask);
+		inTwoMills	= _mm256_or_si256(inTwoMills, _mm256_and_si256(inMill, squares));
+		inMill		= _mm256_or_si256(inMill, squares);
+		curMills	= _mm256_sub_epi32(curMills, curClosed);
+		oppMills	= _mm256_sub_epi32(oppMills, oppClosed);
+	}
+	_mm256_store_si256(reinterpret_cast<__m256i*>(stonesInMill.data()),			inMill);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(stonesInTwoMills.data()),		inTwoMills);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(curPlayerNumberOfMills.data()),	curMills);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(oppPlayerNumberOfMills.data()),	oppMills);
+
+	// moves along the lines, counting both directions of each connection
+	__m256i curAlong = zero;
+	__m256i oppAlong = zero;
+	for (const auto& connection : topology::connections) {
+		const __m256i a		= _mm256_set1_epi32(connection[0]);
+		const __m256i b		= _mm256_set1_epi32(connection[1]);
+		const __m256i freeA	= _mm256_srlv_epi32(freeSquares, a);
+		const __m256i freeB	= _mm256_srlv_epi32(freeSquares, b);
+		curAlong = _mm256_add_epi32(curAlong, _mm256_and_si256(_mm256_and_si256(_mm256_srlv_epi32(cur, a), freeB), one));
+		curAlong = _mm256_add_epi32(curAlong, _mm256_and_si256(_mm256_and_si256(_mm256_srlv_epi32(cur, b), freeA), one));
+		oppAlong = _mm256_add_epi32(oppAlong, _mm256_and_si256(_mm256_and_si256(_mm256_srlv_epi32(opp, a), freeB), one));
+		oppAlong = _mm256_add_epi32(oppAlong, _mm256_and_si256(_mm256_and_si256(_mm256_srlv_epi32(opp, b), freeA), one));
+	}
+
+	// possible moves, selected by the phase and the number of stones like in calcNumPossibleMoves()
+	auto numPossibleMoves = [&](__m256i numStones, __m256i along, __m256i& alongLines) -> __m256i {
+		const __m256i jump	= rules::jumpingAllowed ? _mm256_cmpeq_epi32(numStones, _mm256_set1_epi32(rules::numStonesForJumping)) : zero;
+		alongLines			= _mm256_andnot_si256(jump, _mm256_cmpgt_epi32(numStones, _mm256_set1_epi32(2)));
+		__m256i numMoves	= _mm256_or_si256(_mm256_and_si256(alongLines, along), _mm256_and_si256(jump, _mm256_mullo_epi32(numStones, numFree)));
+		return _mm256_blendv_epi8(numMoves, numFree, setting);
+	};
+	__m256i			curAlongLines, oppAlongLines;
+	const __m256i	curMoves		= numPossibleMoves(curNumStones, curAlong, curAlongLines);
+	const __m256i	oppMoves		= numPossibleMoves(oppNumStones, oppAlong, oppAlongLines);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(curPlayerNumPossibleMoves.data()),	curMoves);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(oppPlayerNumPossibleMoves.data()),	oppMoves);
+
+	// removable stones of the opponent
+	const __m256i	oppFree			= _mm256_andnot_si256(inMill, opp);
+	const __m256i	oppHasOnlyMills	= _mm256_andnot_si256(_mm256_cmpeq_epi32(oppMills, zero), _mm256_cmpeq_epi32(oppFree, zero));
+	__m256i			removable		= oppFree;
+	if (rules::removeFromMillIfOnlyMills) {
+		const __m256i oppInMill = rules::removeFromTwoMills ? _mm256_and_si256(opp, inMill) : _mm256_andnot_si256(inTwoMills, _mm256_and_si256(opp, inMill));
+		removable = _mm256_or_si256(removable, _mm256_and_si256(oppHasOnlyMills, oppInMill));
+	}
+	_mm256_store_si256(reinterpret_cast<__m256i*>(removableStones.data()), removable);
+
+	// winner, where the later assignments take precedence like the order of the checks in getWinner()
+	const __m256i	curImmobile		= _mm256_and_si256(curAlongLines, _mm256_cmpeq_epi32(curMoves, zero));
+	__m256i			result			= zero;
+	result = _mm256_blendv_epi8(result, _mm256_set1_epi32(oppPlayerWon), curImmobile);
+	result = _mm256_blendv_epi8(result, _mm256_set1_epi32(oppPlayerWon), _mm256_cmpgt_epi32(three, curNumStones));
+	result = _mm256_blendv_epi8(result, _mm256_set1_epi32(curPlayerWon), _mm256_cmpgt_epi32(three, oppNumStones));
+	result = _mm256_andnot_si256(setting, result);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(winner.data()), result);
+}
+#else
+//-----------------------------------------------------------------------------
+// Name: calculateSimd()
+// Desc: Without AVX2 the lanes are calculated one after another.
+//-----------------------------------------------------------------------------
+void fieldBatch::calculateSimd()
+{
+	calculateScalar();
+}
+#endif
+
+#pragma endregion
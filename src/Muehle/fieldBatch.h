@@ -0,0 +1,69 @@
+/*********************************************************************\
+	fieldBatch.h
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+\*********************************************************************/
+
+#ifndef FIELD_BATCH_H
+#define FIELD_BATCH_H
+
+#include <array>
+#include <cstdint>
+
+#include "fieldStruct.h"
+
+/*** Classes *******************************************************/
+
+// Structure of arrays holding the bit boards of several game states, one state per lane.
+// The deduced variables of all lanes are calculated at once, with AVX2 if the compiler targets it, and otherwise by a scalar loop.
+// Each result equals the corresponding variable of a fieldStruct being in the same state.
+class fieldBatch : public fieldStruct_types
+{
+public:
+	// constants
+	static const unsigned int	numLanes						= 8;						// one 32 bit lane of a 256 bit register per state
+	static const bool			simdEnabled;												// true if calculate() uses AVX2
+
+	// result of the game in each lane
+	static constexpr std::uint32_t	gameNotFinished				= 0;
+	static constexpr std::uint32_t	curPlayerWon				= 1;
+	static constexpr std::uint32_t	oppPlayerWon				= 2;
+
+	using laneArray				= std::array<std::uint32_t, numLanes>;
+
+	// input, set by set()
+	alignas(32) laneArray		curPlayerStones					{};							// bit board of the current player
+	alignas(32) laneArray		oppPlayerStones					{};							// bit board of the opponent
+	alignas(32) laneArray		settingPhase					{};							// 1 if the state is in the setting phase, otherwise 0
+
+	// output, calculated by calculate()
+	alignas(32) laneArray		stonesInMill					{};							// squares being part of at least one closed mill, thus stonePartOfMill[pos] > 0
+	alignas(32) laneArray		stonesInTwoMills				{};							// squares being part of two closed mills, thus stonePartOfMill[pos] > 1
+	alignas(32) laneArray		curPlayerNumberOfMills			{};							// playerStruct::numberOfMills of the current player
+	alignas(32) laneArray		oppPlayerNumberOfMills			{};							// '' opponent
+	alignas(32) laneArray		curPlayerNumPossibleMoves		{};							// playerStruct::numPossibleMoves of the current player
+	alignas(32) laneArray		oppPlayerNumPossibleMoves		{};							// '' opponent
+	alignas(32) laneArray		removableStones					{};							// opponent stones, which could be removed after closing a mill
+	alignas(32) laneArray		winner							{};							// gameNotFinished, curPlayerWon or oppPlayerWon
+
+	// setter
+	void						set								(unsigned int lane, const packedCore& state);
+	void						clear							();
+
+	// calculation of the output for all lanes
+	void						calculate						();
+	void						calculateScalar					();
+
+	// getter
+	unsigned int				getStonePartOfMill				(unsigned int lane, fieldPos pos) const;
+
+private:
+	static_assert(tables::maxMillsPerSquare <= 2, "stonesInMill and stonesInTwoMills can only represent two mills per square");
+	static_assert(size < 32, "the bit board of each state must fit into a 32 bit lane");
+
+	void						calculateLane					(unsigned int lane);
+	void						calculateSimd					();
+};
+
+#endif
@@ -8,15 +8,9 @@
 #include "fieldStruct.h"
 #include <cassert>
 #include <algorithm>
+#include <random>
 
-// Field indices
-//  0------- 1----- 2
-// |   3---- 4--- 5 |
-// |  |   6- 7- 8 | |
-//  9-10-11    12-13-14
-// |  |  15-16-17 | |
-// |  18----19---20 |
-// 21-------22------23
+// The squares of each board are numbered as shown in boardTopology.h
 
 using namespace std;
 
@@ -34,7 +28,8 @@ bool playerStruct::operator==(const playerStruct &other) const
 	 && numStonesMissing 	== other.numStonesMissing
 	 && numPossibleMoves 	== other.numPossibleMoves
 	 && warning 			== other.warning
-	 && numStonesSet 		== other.numStonesSet;
+	 && numStonesSet 		== other.numStonesSet
+	 && stones 				== other.stones;
 }
 
 #pragma endregion
@@ -65,7 +60,7 @@ bool moveInfo::operator==(const moveInfo& other) const
 //-----------------------------------------------------------------------------
 moveInfo::possibilityId moveInfo::getId() const
 {
-	return (from * (fieldStruct::size + 1) + to) * (fieldStruct::size + 1) + removeStone;
+	return packedMove{from, to, removeStone}.id;
 }
 
 //-----------------------------------------------------------------------------
@@ -75,12 +70,10 @@ moveInfo::possibilityId moveInfo::getId() const
 void moveInfo::setId(possibilityId id)
 {
 	// Perform consistency checks
-	if (id >= ((fieldStruct::size + 1) * (fieldStruct::size + 1) * (fieldStruct::size + 1))) {
+	if (id >= packedMove::numIds) {
 		throw std::out_of_range("Invalid possibilityId: id exceeds the maximum allowed value.");
 	}
-	from 		= id / ((fieldStruct::size + 1) * (fieldStruct::size + 1));
-	to 			= (id / (fieldStruct::size + 1)) % (fieldStruct::size + 1);
-	removeStone = id % (fieldStruct::size + 1);
+	*this = packedMove{id}.toMoveInfo();
 }
 
 //-----------------------------------------------------------------------------
@@ -94,13 +87,12 @@ bool moveInfo::isSettingPhase() const
 
 //-----------------------------------------------------------------------------
 // Name: getMoveInfo()
-// Desc: Returns the moveInfo for a given id
+// Desc: Returns the moveInfo for a given id. 
+//       In contrast to setId() no exception is thrown. An invalid id results in the default moveInfo, which is refused by move().
 //-----------------------------------------------------------------------------
-const moveInfo &moveInfo::getMoveInfo(possibilityId id)
+moveInfo moveInfo::getMoveInfo(possibilityId id)
 {
-	static moveInfo move;
-	move.setId(id);
-	return move;
+	return (id < packedMove::numIds) ? packedMove{id}.toMoveInfo() : moveInfo{};
 }
 #pragma endregion
 
@@ -110,7 +102,8 @@ const moveInfo &moveInfo::getMoveInfo(possibilityId id)
 // Name: fieldStruct()
 // Desc: Constructor
 //-----------------------------------------------------------------------------
-fieldStruct::fieldStruct()
+template <class boardTopology>
+fieldStructOf<boardTopology>::fieldStructOf()
 {
 	reset();
 }
@@ -119,23 +112,18 @@ fieldStruct::fieldStruct()
 // Name: fieldStruct()
 // Desc: Copy Constructor
 //-----------------------------------------------------------------------------
-fieldStruct::fieldStruct(const fieldStruct& other)
-    : fieldStruct_forward(other), fieldStruct_reverse(other)
+template <class boardTopology>
+fieldStructOf<boardTopology>::fieldStructOf(const fieldStructOf& other)
+    : reverse(other)
 {
-	// Copy the core variables from the other fieldStruct
-	this->field = other.field;
-	this->settingPhase = other.settingPhase;
-	this->curPlayer = other.curPlayer;
-	this->oppPlayer = other.oppPlayer;
-	this->stonePartOfMill = other.stonePartOfMill;
-	this->gameHasFinished = other.gameHasFinished;
 }
 
 //-----------------------------------------------------------------------------
 // Name: ~fieldStruct()
 // Desc: Destructor
 //-----------------------------------------------------------------------------
-fieldStruct::~fieldStruct()
+template <class boardTopology>
+fieldStructOf<boardTopology>::~fieldStructOf()
 {
 }
 
@@ -143,11 +131,16 @@ fieldStruct::~fieldStruct()
 // Name: operator==()
 // Desc: Compares two fieldStructs
 //-----------------------------------------------------------------------------
-bool fieldStruct::operator==(const fieldStruct &other) const
+template <class boardTopology>
+bool fieldStructOf<boardTopology>::operator==(const fieldStructOf &other) const
 {
+	updateDeduced(allDirty);
+	other.updateDeduced(allDirty);
+
 	return curPlayer         == other.curPlayer
 		&& oppPlayer        == other.oppPlayer
 		&& settingPhase     == other.settingPhase
+		&& removalPending   == other.removalPending
 		&& gameHasFinished  == other.gameHasFinished
 		&& field            == other.field
 		&& stonePartOfMill  == other.stonePartOfMill;
@@ -180,7 +173,8 @@ playerStruct::core::core(const playerStruct &player)
 // Name: fieldStruct::core()
 // Desc: Constructor
 //-----------------------------------------------------------------------------
-fieldStruct::core::core()
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::core::core()
 {
 }
 
@@ -188,19 +182,21 @@ fieldStruct::core::core()
 // Name: fieldStruct::core()
 // Desc: Constructor
 //-----------------------------------------------------------------------------
-fieldStruct::core::core(const fieldStruct_variables &vars)
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::core::core(const fieldStructOf_variables<boardTopology> &vars)
 {
 	field               = vars.getField();
 	settingPhase        = vars.inSettingPhase();
-	curPlayer           = vars.getCurPlayer();
-	oppPlayer           = vars.getOppPlayer();
+	curPlayer           = vars.curPlayer;
+	oppPlayer           = vars.oppPlayer;
 }
 
 //-----------------------------------------------------------------------------
 // Name: 
 // Desc: 
 //-----------------------------------------------------------------------------
-const playerStruct::core &fieldStruct_types::core::getCurPlayer() const
+template <class boardTopology>
+const playerStruct::core &fieldStructOf_types<boardTopology>::core::getCurPlayer() const
 {
     return curPlayer;
 }
@@ -209,7 +205,8 @@ const playerStruct::core &fieldStruct_types::core::getCurPlayer() const
 // Name: 
 // Desc: 
 //-----------------------------------------------------------------------------
-const playerStruct::core &fieldStruct_types::core::getOppPlayer() const
+template <class boardTopology>
+const playerStruct::core &fieldStructOf_types<boardTopology>::core::getOppPlayer() const
 {
     return oppPlayer;
 }
@@ -218,7 +215,8 @@ const playerStruct::core &fieldStruct_types::core::getOppPlayer() const
 // Name: 
 // Desc: 
 //-----------------------------------------------------------------------------
-playerId fieldStruct_types::core::getStone(fieldPos pos) const
+template <class boardTopology>
+playerId fieldStructOf_types<boardTopology>::core::getStone(fieldPos pos) const
 {
     return field[pos];
 }
@@ -227,11 +225,114 @@ playerId fieldStruct_types::core::getStone(fieldPos pos) const
 // Name: 
 // Desc: 
 //-----------------------------------------------------------------------------
-bool fieldStruct_types::core::inSettingPhase() const
+template <class boardTopology>
+bool fieldStructOf_types<boardTopology>::core::inSettingPhase() const
 {
     return settingPhase;
 }
 
+//-----------------------------------------------------------------------------
+// Name: fieldStruct::packedCore()
+// Desc: Constructor
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::packedCore::packedCore()
+{
+}
+
+//-----------------------------------------------------------------------------
+// Name: fieldStruct::packedCore()
+// Desc: Constructor
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::packedCore::packedCore(const core& state)
+{
+	bitBoard curPlayerStones = 0;
+	bitBoard oppPlayerStones = 0;
+
+	for (fieldPos pos = 0; pos < size; pos++) {
+		if (state.field[pos] == state.curPlayer.id) curPlayerStones |= squareMask(pos);
+		if (state.field[pos] == state.oppPlayer.id) oppPlayerStones |= squareMask(pos);
+	}
+
+	bits	= std::uint64_t{curPlayerStones}
+			| std::uint64_t{oppPlayerStones}						<< oppStonesShift
+			| std::uint64_t{state.curPlayer.numStonesMissing}		<< curMissingShift
+			| std::uint64_t{state.oppPlayer.numStonesMissing}		<< oppMissingShift
+			| std::uint64_t{state.settingPhase}						<< settingPhaseShift
+			| std::uint64_t{state.curPlayer.id == playerId::playerTwo}	<< curPlayerShift;
+}
+
+//-----------------------------------------------------------------------------
+// Name: fieldStruct::packedCore()
+// Desc: Constructor. Only the occupancy masks of the players are read, but not the field array.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::packedCore::packedCore(const fieldStructOf_variables<boardTopology>& vars)
+{
+	const playerStruct& curPlayer = vars.curPlayer;
+	const playerStruct& oppPlayer = vars.oppPlayer;
+
+	bits	= std::uint64_t{curPlayer.stones}
+			| std::uint64_t{oppPlayer.stones}						<< oppStonesShift
+			| std::uint64_t{curPlayer.numStonesMissing}				<< curMissingShift
+			| std::uint64_t{oppPlayer.numStonesMissing}				<< oppMissingShift
+			| std::uint64_t{vars.inSettingPhase()}					<< settingPhaseShift
+			| std::uint64_t{curPlayer.id == playerId::playerTwo}	<< curPlayerShift;
+}
+
+//-----------------------------------------------------------------------------
+// Name: fieldStruct::packedCore()
+// Desc: Constructor from the single components of the state
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+fieldStructOf_types<boardTopology>::packedCore::packedCore(bitBoard curPlayerStones, bitBoard oppPlayerStones, unsigned int curPlayerNumStonesMissing, unsigned int oppPlayerNumStonesMissing, bool settingPhase, playerId curPlayerId)
+{
+	bits	= std::uint64_t{curPlayerStones}
+			| std::uint64_t{oppPlayerStones}						<< oppStonesShift
+			| std::uint64_t{curPlayerNumStonesMissing}				<< curMissingShift
+			| std::uint64_t{oppPlayerNumStonesMissing}				<< oppMissingShift
+			| std::uint64_t{settingPhase}							<< settingPhaseShift
+			| std::uint64_t{curPlayerId == playerId::playerTwo}		<< curPlayerShift;
+}
+
+//-----------------------------------------------------------------------------
+// Name: fieldStruct::packedCore::withStones()
+// Desc: Returns a copy, whose squares of the current and the opponent player are replaced. 
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+typename fieldStructOf_types<boardTopology>::packedCore fieldStructOf_types<boardTopology>::packedCore::withStones(bitBoard curPlayerStones, bitBoard oppPlayerStones) const
+{
+	packedCore state;
+	state.bits	= (bits & ~((std::uint64_t{1} << curMissingShift) - 1))
+				| std::uint64_t{curPlayerStones}
+				| std::uint64_t{oppPlayerStones}						<< oppStonesShift;
+	return state;
+}
+
+//-----------------------------------------------------------------------------
+// Name: unpack()
+// Desc: Returns the state as core
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+typename fieldStructOf_types<boardTopology>::core fieldStructOf_types<boardTopology>::packedCore::unpack() const
+{
+	core state;
+
+	state.field.fill(playerId::squareIsFree);
+	for (bitBoard squares = getCurPlayerStones(); squares; ) state.field[popSquare(squares)] = getCurPlayerId();
+	for (bitBoard squares = getOppPlayerStones(); squares; ) state.field[popSquare(squares)] = getOppPlayerId();
+
+	state.settingPhase					= inSettingPhase();
+	state.curPlayer.id					= getCurPlayerId();
+	state.curPlayer.numStones			= getCurPlayerNumStones();
+	state.curPlayer.numStonesMissing	= getCurPlayerNumStonesMissing();
+	state.oppPlayer.id					= getOppPlayerId();
+	state.oppPlayer.numStones			= getOppPlayerNumStones();
+	state.oppPlayer.numStonesMissing	= getOppPlayerNumStonesMissing();
+	return state;
+}
+
 #pragma endregion
 
 #pragma region fieldStruct_variables
@@ -239,115 +340,59 @@ bool fieldStruct_types::core::inSettingPhase() const
 //-----------------------------------------------------------------------------
 // static variables
 //-----------------------------------------------------------------------------
-const fieldStruct::Array2d<fieldStruct::fieldPos, fieldStruct::size, 4> fieldStruct_variables::connectedSquare = []() {
+// the zobrist keys are generated with a fixed seed, so that they are identical on every run and platform
+template <class boardTopology>
+const typename fieldStructOf_variables<boardTopology>::zobristSquareArray fieldStructOf_variables<boardTopology>::zobristSquare = []() {
 	// locals
-	Array2d<fieldPos, size, 4> connectedSquare;
-	auto i = size;
-
-	// set connections
-	setConnection(connectedSquare,  0,  1,  9,  i,  i);
-	setConnection(connectedSquare,  1,  2,  4,  0,  i);
-	setConnection(connectedSquare,  2,  i, 14,  1,  i);
-	setConnection(connectedSquare,  3,  4, 10,  i,  i);
-	setConnection(connectedSquare,  4,  5,  7,  3,  1);
-	setConnection(connectedSquare,  5,  i, 13,  4,  i); 
-	setConnection(connectedSquare,  6,  7, 11,  i,  i);
-	setConnection(connectedSquare,  7,  8,  i,  6,  4);
-	setConnection(connectedSquare,  8,  i, 12,  7,  i);
-	setConnection(connectedSquare,  9, 10, 21,  i,  0);
-	setConnection(connectedSquare, 10, 11, 18,  9,  3);
-	setConnection(connectedSquare, 11,  i, 15, 10,  6);
-	setConnection(connectedSquare, 12, 13, 17,  i,  8);
-	setConnection(connectedSquare, 13, 14, 20, 12,  5);
-	setConnection(connectedSquare, 14,  i, 23, 13,  2);
-	setConnection(connectedSquare, 15, 16,  i,  i, 11);
-	setConnection(connectedSquare, 16, 17, 19, 15,  i);
-	setConnection(connectedSquare, 17,  i,  i, 16, 12);
-	setConnection(connectedSquare, 18, 19,  i,  i, 10);
-	setConnection(connectedSquare, 19, 20, 22, 18, 16);
-	setConnection(connectedSquare, 20,  i,  i, 19, 13);
-	setConnection(connectedSquare, 21, 22,  i,  i,  9);
-	setConnection(connectedSquare, 22, 23,  i, 21, 19);
-	setConnection(connectedSquare, 23,  i,  i, 22, 14);
-
-	return connectedSquare;
+	zobristSquareArray zobristSquare;
+	std::mt19937_64 randomEngine(0x4d75656865ull);
+
+	for (auto& keysOfPlayer : zobristSquare) {
+		for (auto& key : keysOfPlayer) key = randomEngine();
+	}
+	return zobristSquare;
 }();
 
-const fieldStruct::Array3d<fieldStruct::fieldPos, fieldStruct::size, 2, 2> fieldStruct_variables::neighbour = []() {
+template <class boardTopology>
+const typename fieldStructOf_variables<boardTopology>::zobristMissingArray fieldStructOf_variables<boardTopology>::zobristMissing = []() {
 	// locals
-	Array3d<fieldPos, size, 2, 2> neighbour;
-
-	// neighbours
-	setNeighbour(neighbour,  0,  1,  2,  9, 21);
-	setNeighbour(neighbour,  1,  0,  2,  4,  7);
-	setNeighbour(neighbour,  2,  0,  1, 14, 23);
-	setNeighbour(neighbour,  3,  4,  5, 10, 18);
-	setNeighbour(neighbour,  4,  1,  7,  3,  5);
-	setNeighbour(neighbour,  5,  3,  4, 13, 20);
-	setNeighbour(neighbour,  6,  7,  8, 11, 15);
-	setNeighbour(neighbour,  7,  1,  4,  6,  8);
-	setNeighbour(neighbour,  8,  6,  7, 12, 17);
-	setNeighbour(neighbour,  9, 10, 11,  0, 21);
-	setNeighbour(neighbour, 10,  9, 11,  3, 18);
-	setNeighbour(neighbour, 11,  9, 10,  6, 15);
-	setNeighbour(neighbour, 12, 13, 14,  8, 17);
-	setNeighbour(neighbour, 13, 12, 14,  5, 20);
-	setNeighbour(neighbour, 14, 12, 13,  2, 23);
-	setNeighbour(neighbour, 15,  6, 11, 16, 17);
-	setNeighbour(neighbour, 16, 15, 17, 19, 22);
-	setNeighbour(neighbour, 17, 15, 16,  8, 12);
-	setNeighbour(neighbour, 18,  3, 10, 19, 20);
-	setNeighbour(neighbour, 19, 18, 20, 16, 22);
-	setNeighbour(neighbour, 20,  5, 13, 18, 19);
-	setNeighbour(neighbour, 21,  0,  9, 22, 23);
-	setNeighbour(neighbour, 22, 16, 19, 21, 23);
-	setNeighbour(neighbour, 23,  2, 14, 21, 22);
-	return neighbour;
+	zobristMissingArray zobristMissing;
+	std::mt19937_64 randomEngine(0x4d697373696eull);
+
+	for (auto& keysOfPlayer : zobristMissing) {
+		for (auto& key : keysOfPlayer) key = randomEngine();
+	}
+	return zobristMissing;
 }();
 
+template <class boardTopology> const hashKey fieldStructOf_variables<boardTopology>::zobristSettingPhase 	= std::mt19937_64(0x53657474696eull)();
+template <class boardTopology> const hashKey fieldStructOf_variables<boardTopology>::zobristPlayerTwoToMove	= std::mt19937_64(0x506c61796572ull)();
+template <class boardTopology> const hashKey fieldStructOf_variables<boardTopology>::zobristRemovalPending	= std::mt19937_64(0x52656d6f7665ull)();
+
+// validation level used by the move generators
+template <class boardTopology> validationLevel fieldStructOf_variables<boardTopology>::validation				= static_cast<validationLevel>(MUEHLE_VALIDATION_LEVEL);
+template <class boardTopology> validationLevel fieldStructOf_variables<boardTopology>::predecessorValidation	= validationLevel::full;
+
 //-----------------------------------------------------------------------------
 // Name: printField()
 // Desc: Prints the field to the console
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::print() const
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::print() const
 {
 	// locals
-	std::array<char, size> c;
-	const bool longVersion = false;
-
-	for (fieldPos index=0; index<size; index++) {
-		c[index] = getCharFromStone(field[index]);
-	}
+	fieldPos pos = 0;
 
     cout << "current player          : " << getCharFromStone(curPlayer.id) << " has " << curPlayer.numStones << " stones (set " << curPlayer.numStonesSet << ")\n";
     cout << "opponent player         : " << getCharFromStone(oppPlayer.id) << " has " << oppPlayer.numStones << " stones (set " << oppPlayer.numStonesSet << ")\n";
 	cout << "setting phase           : " << (settingPhase ? "true" : "false");
-	if (longVersion) {
-		cout << "\n";
-		cout << "\n   a-----b-----c   " << c[0] << "-----" << c[1] << "-----" << c[2];
-		cout << "\n   |     |     |   " << "|     |     |";
-		cout << "\n   | d---e---f |   " << "| " << c[3] << "---" << c[4] << "---" << c[5] << " |";
-		cout << "\n   | |   |   | |   " << "| |   |   | |";
-		cout << "\n   | | g-h-i | |   " << "| | " << c[6] << "-" << c[7] << "-" << c[8] << " | |";
-		cout << "\n   | | | | | | |   " << "| | |   | | |";
-		cout << "\n   j-k-l   m-n-o   " << c[9] << "-" << c[10] << "-" << c[11] << "   " << c[12] << "-" << c[13] << "-" << c[14];
-		cout << "\n   | | | | | | |   " << "| | |   | | |";
-		cout << "\n   | | p-q-r | |   " << "| | " << c[15] << "-" << c[16] << "-" << c[17] << " | |";
-		cout << "\n   | |   |   | |   " << "| |   |   | |";
-		cout << "\n   | s---t---u |   " << "| " << c[18] << "---" << c[19] << "---" << c[20] << " |";
-		cout << "\n   |     |     |   " << "|     |     |";
-		cout << "\n   v-----w-----x   " << c[21] << "-----" << c[22] << "-----" << c[23];
-		cout << "\n" << endl;
-	} else {
-		cout << "\n" << c[0] << "-----" << c[1] << "-----" << c[2];
-		cout << "\n" << "| " << c[3] << "---" << c[4] << "---" << c[5] << " |";
-		cout << "\n" << "| | " << c[6] << "-" << c[7] << "-" << c[8] << " | |";
-		cout << "\n" << c[9] << "-" << c[10] << "-" << c[11] << "   " << c[12] << "-" << c[13] << "-" << c[14];
-		cout << "\n" << "| | " << c[15] << "-" << c[16] << "-" << c[17] << " | |";
-		cout << "\n" << "| " << c[18] << "---" << c[19] << "---" << c[20] << " |";
-		cout << "\n" << c[21] << "-----" << c[22] << "-----" << c[23];
-		cout << "\n" << endl;
+
+	// each '#' of the layout stands for the next square
+	cout << "\n";
+	for (const char* c = topology::layout; *c; c++) {
+		cout << (*c == '#' ? getCharFromStone(field[pos++]) : *c);
 	}
+	cout << "\n" << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -355,18 +400,20 @@ void fieldStruct_variables::print() const
 // Desc: Resets the field to the initial state, including both players' warnings and all relevant state.
 //       This function ensures that both players' warnings, stone counts, mills, and the board state are fully reset.
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::reset(playerId firstPlayer)
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::reset(playerId firstPlayer)
 {
 	gameHasFinished				= false;
 	curPlayer.id				= firstPlayer;
 	settingPhase				= true;
+	removalPending				= false;
 	curPlayer.warning			= (curPlayer.id == playerId::playerOne) ? warningId::playerOneWarning	: warningId::playerTwoWarning;
 	oppPlayer.id				= (curPlayer.id == playerId::playerOne) ? playerId::playerTwo			: playerId::playerOne;
 	oppPlayer.warning			= (curPlayer.id == playerId::playerOne) ? warningId::playerTwoWarning	: warningId::playerOneWarning;
 	curPlayer.numStones			= 0;
 	oppPlayer.numStones			= 0;
-	curPlayer.numPossibleMoves	= 24;
-	oppPlayer.numPossibleMoves	= 0;
+	curPlayer.numPossibleMoves	= size;
+	oppPlayer.numPossibleMoves	= size;
 	curPlayer.numStonesMissing	= 0;
 	oppPlayer.numStonesMissing	= 0;
 	curPlayer.numberOfMills		= 0;
@@ -375,17 +422,25 @@ void fieldStruct_variables::reset(playerId firstPlayer)
 	oppPlayer.numStonesSet		= 0;
 	curPlayer.hasOnlyMills		= false;
 	oppPlayer.hasOnlyMills		= false;
+	curPlayer.stones			= 0;
+	oppPlayer.stones			= 0;
 
 	field.fill(playerId::squareIsFree);
 	stonePartOfMill.fill(0);
+	calcHashKey();
+	dirty = 0;
 }
 
 //-----------------------------------------------------------------------------
 // Name: invert()
 // Desc: Switches the players and inverts the field
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::invert()
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::invert()
 {
+	// the deduced variables of each player are swapped together with the players, thus they must be known before
+	updateDeduced(allDirty & ~(stonePartOfMillDirty | hashDirty));
+
 	std::swap(curPlayer, oppPlayer);
 
     for (fieldPos k=0; k<size; k++) {
@@ -396,13 +451,18 @@ void fieldStruct_variables::invert()
 		case playerId::playerTwoWarning:field[k] = playerId::playerOneWarning;	break;
 		}
     }
+
+	// the stones stay on their squares, but now belong to the other player id
+	calcStoneMasks();
+	dirty |= hashDirty;
 }
 
 //-----------------------------------------------------------------------------
 // Name: getCharFromStone()
 // Desc: Returns the char representation of a stone
 //-----------------------------------------------------------------------------
-char fieldStruct_variables::getCharFromStone(playerId stone) const
+template <class boardTopology>
+char fieldStructOf_variables<boardTopology>::getCharFromStone(playerId stone) const
 {
 	switch (stone) 
 	{
@@ -416,51 +476,32 @@ char fieldStruct_variables::getCharFromStone(playerId stone) const
 	return 'f';
 }
 
-//-----------------------------------------------------------------------------
-// Name: setConnection()
-// Desc: Helper function to set 'connectedSquare'
-//-----------------------------------------------------------------------------
-void fieldStruct_variables::setConnection(Array2d<fieldPos, size, 4>& connectedSquare, fieldPos index, int firstDirection, int secondDirection, int thirdDirection, int fourthDirection)
-{
-	connectedSquare[index][0] = firstDirection;
-	connectedSquare[index][1] = secondDirection;
-	connectedSquare[index][2] = thirdDirection;
-	connectedSquare[index][3] = fourthDirection;
-}
-
-//-----------------------------------------------------------------------------
-// Name: setNeighbour()
-// Desc: Helper function to set 'neighbour'
-//-----------------------------------------------------------------------------
-void fieldStruct_variables::setNeighbour(Array3d<fieldPos, size, 2, 2>& neighbour, fieldPos index, fieldPos firstNeighbour0, fieldPos secondNeighbour0, fieldPos firstNeighbour1, fieldPos secondNeighbour1)
-{
-	neighbour[index][0][0] = firstNeighbour0;
-	neighbour[index][0][1] = secondNeighbour0;
-	neighbour[index][1][0] = firstNeighbour1;
-	neighbour[index][1][1] = secondNeighbour1;
-}
-
 //-----------------------------------------------------------------------------
 // Name: getWinner()
 // Desc: Returns the winner of the game, and playerId::squareIsFree if the game is not finished.
 //-----------------------------------------------------------------------------
-playerId fieldStruct_variables::getWinner() const
+template <class boardTopology>
+playerId fieldStructOf_variables<boardTopology>::getWinner() const
 {
-    playerId winner = playerId::squareIsFree;
+	if (settingPhase)				return playerId::squareIsFree;
+	if (oppPlayer.numStones < 3)	return curPlayer.id;
+	if (curPlayer.numStones < 3)	return oppPlayer.id;
 
-    if ((!curPlayer.numPossibleMoves) && (!settingPhase) && (curPlayer.numStones > 3))	{ winner = oppPlayer.id; }
-    if ((curPlayer.numStones < 3) && (!settingPhase))									{ winner = oppPlayer.id; }
-    if ((oppPlayer.numStones < 3) && (!settingPhase))									{ winner = curPlayer.id; }
+	// only now the possible moves of the current player are needed
+	updateDeduced(curPlayerMovesDirty);
+	if (!curPlayer.numPossibleMoves && movesAlongLines(curPlayer.numStones))	return oppPlayer.id;
 
-    return winner;
+	return playerId::squareIsFree;
 }
 
 //-----------------------------------------------------------------------------
 // Name: getCurPlayer()
 // Desc: Returns a reference to the current player
 //-----------------------------------------------------------------------------
-const playerStruct &fieldStruct_variables::getCurPlayer() const
+template <class boardTopology>
+const playerStruct &fieldStructOf_variables<boardTopology>::getCurPlayer() const
 {
+	updateDeduced(numberOfMillsDirty | hasOnlyMillsDirty | curPlayerMovesDirty);
 	return curPlayer;
 }
 
@@ -468,8 +509,10 @@ const playerStruct &fieldStruct_variables::getCurPlayer() const
 // Name: getOppPlayer()
 // Desc: Returns a reference to the opponent player
 //-----------------------------------------------------------------------------
-const playerStruct &fieldStruct_variables::getOppPlayer() const
+template <class boardTopology>
+const playerStruct &fieldStructOf_variables<boardTopology>::getOppPlayer() const
 {
+	updateDeduced(numberOfMillsDirty | hasOnlyMillsDirty | oppPlayerMovesDirty);
 	return oppPlayer;
 }
 
@@ -477,7 +520,8 @@ const playerStruct &fieldStruct_variables::getOppPlayer() const
 // Name: getStone()
 // Desc: Returns the player id of a stone
 //-----------------------------------------------------------------------------
-playerId fieldStruct_variables::getStone(fieldPos pos) const
+template <class boardTopology>
+playerId fieldStructOf_variables<boardTopology>::getStone(fieldPos pos) const
 {
     return field[pos];
 }
@@ -486,16 +530,50 @@ playerId fieldStruct_variables::getStone(fieldPos pos) const
 // Name: isStonePartOfMill()
 // Desc: Returns the number of mills, of which this stone is part of
 //-----------------------------------------------------------------------------
-unsigned int fieldStruct_variables::isStonePartOfMill(fieldPos pos) const
+template <class boardTopology>
+unsigned int fieldStructOf_variables<boardTopology>::isStonePartOfMill(fieldPos pos) const
 {
+	updateDeduced(stonePartOfMillDirty);
     return stonePartOfMill[pos];
 }
 
+//-----------------------------------------------------------------------------
+// Name: getFreeSquares()
+// Desc: Returns the mask of all squares not occupied by any player
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+bitBoard fieldStructOf_variables<boardTopology>::getFreeSquares() const
+{
+    return allSquares & ~(curPlayer.stones | oppPlayer.stones);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getHashKey()
+// Desc: Returns the zobrist key of the current game state
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+hashKey fieldStructOf_variables<boardTopology>::getHashKey() const
+{
+	updateDeduced(hashDirty);
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+// Name: isRemovalPending()
+// Desc: Returns true if the current player closed a mill and has to remove a stone in a separate ply
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::isRemovalPending() const
+{
+    return removalPending;
+}
+
 //-----------------------------------------------------------------------------
 // Name: getField()
 // Desc: Returns the field
 //-----------------------------------------------------------------------------
-const fieldStruct_variables::fieldArray &fieldStruct_variables::getField() const
+template <class boardTopology>
+const typename fieldStructOf_variables<boardTopology>::fieldArray &fieldStructOf_variables<boardTopology>::getField() const
 {
     return field;
 }
@@ -504,8 +582,10 @@ const fieldStruct_variables::fieldArray &fieldStruct_variables::getField() const
 // Name: hasGameFinished()
 // Desc: Returns true if the game has finished
 //-----------------------------------------------------------------------------
-bool fieldStruct_variables::hasGameFinished() const
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::hasGameFinished() const
 {
+	updateDeduced(winnerDirty);
     return gameHasFinished;
 }
 
@@ -513,7 +593,8 @@ bool fieldStruct_variables::hasGameFinished() const
 // Name: getNumStonesSet()
 // Desc: Returns the number of stones set in the setting phase
 //-----------------------------------------------------------------------------
-unsigned int fieldStruct_variables::getNumStonesSet() const
+template <class boardTopology>
+unsigned int fieldStructOf_variables<boardTopology>::getNumStonesSet() const
 {
     return curPlayer.numStonesSet + oppPlayer.numStonesSet;
 }
@@ -522,17 +603,58 @@ unsigned int fieldStruct_variables::getNumStonesSet() const
 // Name: inSettingPhase()
 // Desc: Returns true if the game is in the setting phase
 //-----------------------------------------------------------------------------
-bool fieldStruct_variables::inSettingPhase() const
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::inSettingPhase() const
 {
     return settingPhase;
 }
 
+//-----------------------------------------------------------------------------
+// Name: calcDeduced()
+// Desc: Calculates the passed deduced variables from the core variables and marks them as up to date.
+//       Variables depending on other deduced variables trigger their calculation first.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcDeduced(unsigned int flags) const
+{
+	if (flags & numberOfMillsDirty) {
+		calcNumberOfMills();
+		dirty &= ~numberOfMillsDirty;
+	}
+	if (flags & stonePartOfMillDirty) {
+		calcStonePartOfMill();
+		dirty &= ~stonePartOfMillDirty;
+	}
+	if (flags & hasOnlyMillsDirty) {
+		updateDeduced(numberOfMillsDirty);
+		calcHasOnlyMills();
+		dirty &= ~hasOnlyMillsDirty;
+	}
+	if (flags & curPlayerMovesDirty) {
+		calcNumPossibleMoves(curPlayer);
+		dirty &= ~curPlayerMovesDirty;
+	}
+	if (flags & oppPlayerMovesDirty) {
+		calcNumPossibleMoves(oppPlayer);
+		dirty &= ~oppPlayerMovesDirty;
+	}
+	if (flags & winnerDirty) {
+		gameHasFinished = (getWinner() != playerId::squareIsFree);
+		dirty &= ~winnerDirty;
+	}
+	if (flags & hashDirty) {
+		calcHashKey();
+		dirty &= ~hashDirty;
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Name: calcHasOnlyMills()
 // Desc: Updates 'hasOnlyMills'.
 //       IMPORTANT: stonePartOfMill and field must be in sync!
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcHasOnlyMills()
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcHasOnlyMills() const
 {
 	// update each player
 	for (playerStruct* player : {&oppPlayer, &curPlayer}) {
@@ -543,13 +665,12 @@ void fieldStruct_variables::calcHasOnlyMills()
 			continue;
 		}
 
-		player->hasOnlyMills = true;
-		for (fieldPos i = 0; i < size; i++) {
-			if (field[i] == player->id && !stonePartOfMill[i]) {
-				player->hasOnlyMills = false;
-				break;
-			}
+		// collect the stones being part of a closed mill
+		bitBoard stonesInMills = 0;
+		for (bitBoard mill : mills) {
+			if ((player->stones & mill) == mill) stonesInMills |= mill;
 		}
+		player->hasOnlyMills = (player->stones & ~stonesInMills) == 0;
 	}
 }
 
@@ -557,32 +678,43 @@ void fieldStruct_variables::calcHasOnlyMills()
 // Name: calcNumberOfMills()
 // Desc: Updates the number of mills for each player 
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcNumberOfMills()
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcNumberOfMills() const
 {
 	// count completed mills
 	curPlayer.numberOfMills = 0;
 	oppPlayer.numberOfMills = 0;
-	for (fieldPos i=0; i<size; i++) {
-		if (field[i] == curPlayer.id)	curPlayer.numberOfMills += stonePartOfMill[i];
-		else							oppPlayer.numberOfMills += stonePartOfMill[i];
+	for (bitBoard mill : mills) {
+		if ((curPlayer.stones & mill) == mill) curPlayer.numberOfMills++;
+		if ((oppPlayer.stones & mill) == mill) oppPlayer.numberOfMills++;
 	}
-	curPlayer.numberOfMills /= 3;
-	oppPlayer.numberOfMills /= 3;
 }
 
 //-----------------------------------------------------------------------------
 // Name: calcNumStones()
 // Desc: Updates the number of stones for each player
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcNumStones()
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcNumStones()
 {
 	// count stones
-	curPlayer.numStones = 0;
-	oppPlayer.numStones = 0;
+	curPlayer.numStones = std::popcount(curPlayer.stones);
+	oppPlayer.numStones = std::popcount(oppPlayer.stones);
+}
+
+//-----------------------------------------------------------------------------
+// Name: calcStoneMasks()
+// Desc: Updates the bit masks of both players from the field array
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcStoneMasks()
+{
+	curPlayer.stones = 0;
+	oppPlayer.stones = 0;
 	for (fieldPos i=0; i<size; i++) {
 		if (field[i] == playerId::squareIsFree) continue;
-		if (field[i] == curPlayer.id)	curPlayer.numStones++;
-		else							oppPlayer.numStones++;
+		if (field[i] == curPlayer.id)	curPlayer.stones |= squareMask(i);
+		else							oppPlayer.stones |= squareMask(i);
 	}
 }
 
@@ -599,7 +731,8 @@ void fieldStruct_variables::calcNumStones()
 //		 | 5 					| 2                      | 3                      |
 //		 | ...
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcNumStonesSet(unsigned int totalNumStonesMissing)
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcNumStonesSet(unsigned int totalNumStonesMissing)
 {
 	unsigned int totalNumStonesSet = curPlayer.numStones + oppPlayer.numStones + totalNumStonesMissing;
 	curPlayer.numStonesSet = totalNumStonesSet / 2;
@@ -611,45 +744,27 @@ void fieldStruct_variables::calcNumStonesSet(unsigned int totalNumStonesMissing)
 // Desc: Updates the number of possible moves for a player. 
 //       IMPORTANT: Thereby the possibilities containing a stone removal are not counted.
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcNumPossibleMoves(playerStruct& player) const
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcNumPossibleMoves(playerStruct& player) const
 {
 	// locals
-	fieldPos i, j , k;
-	unsigned int movingDirection;	
+	const bitBoard freeSquares = getFreeSquares();
 
 	// setting phase
 	if (settingPhase) {
-		player.numPossibleMoves = size - curPlayer.numStones - oppPlayer.numStones;
-		return;
-	}
-
-	// normal phase
-	player.numPossibleMoves = 0;
+		player.numPossibleMoves = std::popcount(freeSquares);
 
 	// Only adjacent moves allowed
-	if (player.numStones > 3) {
-		// Optimize by avoiding repeated bounds checks and unnecessary variable assignments
-		for (fieldPos i = 0; i < size; ++i) {
-			if (field[i] != player.id) continue;
-			const auto& connections = connectedSquare[i];
-			for (unsigned int dir = 0; dir < 4; ++dir) {
-				fieldPos j = connections[dir];
-				// Only increment if j is a valid position and free
-				if (j < size && field[j] == playerId::squareIsFree) {
-					++player.numPossibleMoves;
-				}
-			}
+	} else if (movesAlongLines(player.numStones)) {
+		player.numPossibleMoves = 0;
+		for (bitBoard stones = player.stones; stones; ) {
+			player.numPossibleMoves += std::popcount(adjacentSquares[popSquare(stones)] & freeSquares);
 		}
+
 	// Jumping allowed: any free position
-	} else if (player.numStones == 3) {
-		for (i = 0; i < size; ++i) {
-			if (field[i] != player.id) continue;
-			for (j = 0; j < size; ++j) {
-				if (field[j] == playerId::squareIsFree) {
-					player.numPossibleMoves++;
-				}
-			}
-		}
+	} else if (canJump(player.numStones)) {
+		player.numPossibleMoves = std::popcount(player.stones) * std::popcount(freeSquares);
+
 	// Less than 3 stones: no moves possible
 	} else {
 		player.numPossibleMoves = 0;
@@ -660,43 +775,155 @@ void fieldStruct_variables::calcNumPossibleMoves(playerStruct& player) const
 // Name: calcStonePartOfMill()
 // Desc: Updates the stonePartOfMill array for each player
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::calcStonePartOfMill()
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcStonePartOfMill() const
 {
-	for (fieldPos i=0; i<size; i++) {
-		stonePartOfMill[i] = 0;
+	stonePartOfMill.fill(0);
+	for (bitBoard mill : mills) {
+		if ((curPlayer.stones & mill) != mill && (oppPlayer.stones & mill) != mill) continue;
+		for (bitBoard squares = mill; squares; ) {
+			stonePartOfMill[popSquare(squares)]++;
+		}
 	}
-	for (fieldPos i=0; i<size; i++) {
-		setStonePartOfMill(i, neighbour[i][0][0], neighbour[i][0][1]);
-		setStonePartOfMill(i, neighbour[i][1][0], neighbour[i][1][1]);
+}
+
+//-----------------------------------------------------------------------------
+// Name: calcHashKey()
+// Desc: Calculates the zobrist key from scratch. 
+//       Afterwards it is kept up to date incrementally by setSquare(), clearSquare(), setNumStonesMissing() and move().
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::calcHashKey() const
+{
+	hash = 0;
+	for (const playerStruct* player : {&curPlayer, &oppPlayer}) {
+		const unsigned int playerIndex = getPlayerIndex(player->id);
+		for (bitBoard stones = player->stones; stones; ) {
+			hash ^= zobristSquare[playerIndex][popSquare(stones)];
+		}
+		assert(player->numStonesMissing <= numStonesPerPlayer);
+		hash ^= zobristMissing[playerIndex][player->numStonesMissing];
 	}
-	// since every mill was detected 3 times
-	for (fieldPos i=0; i<size; i++) {
-		stonePartOfMill[i] /= 3;
+	if (settingPhase)						hash ^= zobristSettingPhase;
+	if (curPlayer.id == playerId::playerTwo)	hash ^= zobristPlayerTwoToMove;
+	if (removalPending)						hash ^= zobristRemovalPending;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getPlayerIndex()
+// Desc: Returns 0 for playerOne and 1 for playerTwo, used to index the zobrist keys
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+unsigned int fieldStructOf_variables<boardTopology>::getPlayerIndex(playerId id)
+{
+	return (id == playerId::playerOne) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Name: setNumStonesMissing()
+// Desc: Sets the number of missing stones of a player and updates the zobrist key
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::setNumStonesMissing(playerStruct& player, unsigned int numStonesMissing)
+{
+	assert(numStonesMissing <= numStonesPerPlayer);
+	hash ^= zobristMissing[getPlayerIndex(player.id)][player.numStonesMissing];
+	player.numStonesMissing = numStonesMissing;
+	hash ^= zobristMissing[getPlayerIndex(player.id)][player.numStonesMissing];
+}
+
+//-----------------------------------------------------------------------------
+// Name: setSquare()
+// Desc: Puts a stone of 'owner' on a free square, without updating the mills
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::setSquare(fieldPos pos, playerStruct& owner)
+{
+	field[pos]		= owner.id;
+	owner.stones   |= squareMask(pos);
+	hash		   ^= zobristSquare[getPlayerIndex(owner.id)][pos];
+}
+
+//-----------------------------------------------------------------------------
+// Name: clearSquare()
+// Desc: Takes the stone of 'owner' from a square, without updating the mills
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::clearSquare(fieldPos pos, playerStruct& owner)
+{
+	field[pos]		= playerId::squareIsFree;
+	owner.stones   &= ~squareMask(pos);
+	hash		   ^= zobristSquare[getPlayerIndex(owner.id)][pos];
+}
+
+//-----------------------------------------------------------------------------
+// Name: placeStone()
+// Desc: Puts a stone of 'owner' on a free square and registers the mills closed by it
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::placeStone(fieldPos pos, playerStruct& owner)
+{
+	setSquare(pos, owner);
+	for (bitBoard mill : millsOfSquare[pos]) {
+		if ((owner.stones & mill) == mill) updateMill(mill, owner, true);
 	}
 }
 
 //-----------------------------------------------------------------------------
-// Name: setStonePartOfMill()
-// Desc: Sets the stonePartOfMill array 
+// Name: liftStone()
+// Desc: Takes the stone of 'owner' from a square and unregisters the mills destroyed by it
 //-----------------------------------------------------------------------------
-void fieldStruct_variables::setStonePartOfMill(fieldPos stone, fieldPos firstNeighbour, fieldPos secondNeighbour)
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::liftStone(fieldPos pos, playerStruct& owner)
 {
-	// locals
-	playerId rowOwner = field[stone];
+	for (bitBoard mill : millsOfSquare[pos]) {
+		if ((owner.stones & mill) == mill) updateMill(mill, owner, false);
+	}
+	clearSquare(pos, owner);
+}
 
-	// mill closed ?
-	if (rowOwner != playerId::squareIsFree && field[firstNeighbour] == rowOwner && field[secondNeighbour] == rowOwner) {
-		stonePartOfMill[stone]++;
-		stonePartOfMill[firstNeighbour]++;
-		stonePartOfMill[secondNeighbour]++;
+//-----------------------------------------------------------------------------
+// Name: updateMill()
+// Desc: Updates 'stonePartOfMill' and 'numberOfMills' when a mill of 'owner' is closed or destroyed
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_variables<boardTopology>::updateMill(bitBoard mill, playerStruct& owner, bool closed)
+{
+	for (bitBoard squares = mill; squares; ) {
+		if (closed)	stonePartOfMill[popSquare(squares)]++;
+		else		stonePartOfMill[popSquare(squares)]--;
 	}
+	if (closed)	owner.numberOfMills++;
+	else		owner.numberOfMills--;
+}
+
+//-----------------------------------------------------------------------------
+// Name: setSituation()
+// Desc: Sets the field to the state of a core, including the player to move.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::setSituation(const core& state)
+{
+	reset(state.curPlayer.id);
+	return setSituation(state.field, state.settingPhase, state.settingPhase ? state.curPlayer.numStonesMissing + state.oppPlayer.numStonesMissing : 0);
+}
+
+//-----------------------------------------------------------------------------
+// Name: setSituation()
+// Desc: Sets the field to the state of a packed core, including the player to move.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::setSituation(const packedCore& state)
+{
+	return setSituation(state.unpack());
 }
 
 //-----------------------------------------------------------------------------
 // Name: setSituation()
 // Desc: Sets the field to a specific state.
 //-----------------------------------------------------------------------------
-bool fieldStruct_variables::setSituation(const fieldArray& field, bool settingPhase, unsigned int totalNumStonesMissing)
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::setSituation(const fieldArray& field, bool settingPhase, unsigned int totalNumStonesMissing)
 {
 	// Check for too many stones missing
 	if (totalNumStonesMissing > 2*numStonesPerPlayer) return false;
@@ -707,25 +934,29 @@ bool fieldStruct_variables::setSituation(const fieldArray& field, bool settingPh
 	// copy
 	this->field					= field;
 	this->settingPhase			= settingPhase;
-	gameHasFinished				= false;
+	removalPending				= false;
+
+	// the deduced variables are calculated on first access
+	dirty						= allDirty;
 
-	// set .numStones
+	// set .stones and .numStones
+	calcStoneMasks();
 	calcNumStones();
 
-	// if current player already set 9 stones, then it cannot be setting phase any more
-	if (settingPhase && curPlayer.numStones >= 9) return false;
+	// no player can have more stones than given at the beginning
+	if (curPlayer.numStones > numStonesPerPlayer || oppPlayer.numStones > numStonesPerPlayer) return false;
+
+	// if current player already set all stones, then it cannot be setting phase any more
+	if (settingPhase && curPlayer.numStones >= numStonesPerPlayer) return false;
 
 	// if there are too many stones missing, the situation is invalid
 	if (totalNumStonesMissing > 2*numStonesPerPlayer - curPlayer.numStones - oppPlayer.numStones) return false;
 
-	// set .stonePartOfMill
-	calcStonePartOfMill();
-
-	// set .numberOfMills
-	calcNumberOfMills();
-
 	// during setting phase, the total number of missing stones must be at least the number of present on the field
-	if (settingPhase && totalNumStonesMissing < curPlayer.numberOfMills + oppPlayer.numberOfMills) return false;
+	if (settingPhase) {
+		updateDeduced(numberOfMillsDirty);
+		if (totalNumStonesMissing < curPlayer.numberOfMills + oppPlayer.numberOfMills) return false;
+	}
 
 	// stonesSet & numStonesMissing
 	if (settingPhase) {
@@ -743,18 +974,8 @@ bool fieldStruct_variables::setSituation(const fieldArray& field, bool settingPh
 		oppPlayer.numStonesSet 		= numStonesPerPlayer;
 	}
 
-	// if current player set 9 stones, then it cannot be setting phase any more
-	if (settingPhase && curPlayer.numStones + curPlayer.numStonesMissing >= 9) return false;
-
-  	// calculate number of possible moves
-	calcNumPossibleMoves(curPlayer);
-	calcNumPossibleMoves(oppPlayer);
-
-	// update .hasOnlyMills for each player
-	calcHasOnlyMills();
-
-	// when opponent is unable to move than current player has won
-    if (getWinner() != playerId::squareIsFree) { gameHasFinished = true; }
+	// if current player set all stones, then it cannot be setting phase any more
+	if (settingPhase && curPlayer.numStones + curPlayer.numStonesMissing >= numStonesPerPlayer) return false;
 
 	// test if field is ok
 	return isIntegrityOk();
@@ -763,31 +984,24 @@ bool fieldStruct_variables::setSituation(const fieldArray& field, bool settingPh
 //-----------------------------------------------------------------------------
 // Name: isIntegrityOk()
 // Desc: Checks if the field is in a valid state.
+//       validationLevel::cheap only checks the accounting of mills and missing stones during the setting phase,
+//       since this is meant to be the only condition not guaranteed by construction of the predecessors. MuehleVerify checks this.
 //       CAUTION: The following member variables are NOT verified:
 //				  .field, .stonePartOfMill, .gameHasFinished, .hasOnlyMills, .numPossibleMoves, .numStonesMissing, ...
 //-----------------------------------------------------------------------------
-bool fieldStruct_variables::isIntegrityOk() const
+template <class boardTopology>
+bool fieldStructOf_variables<boardTopology>::isIntegrityOk(validationLevel level) const
 {
-	if (settingPhase) {
+	if (level == validationLevel::none) return true;
 
-		// if 18 stones have been set, then it cannot be the setting phase anymore
-		if (getNumStonesSet() >= 18) {
-			return false;
-		}
+	if (settingPhase) {
 
-		// if current player already set 9 stones, then it cannot be setting phase any more
-		if (curPlayer.numStones >= 9) return false;
-
-		// if there are too many stones missing, the situation is invalid
-		if (curPlayer.numStonesMissing + oppPlayer.numStonesMissing > 2*numStonesPerPlayer - curPlayer.numStones - oppPlayer.numStones) return false;
+		// the mills are calculated on first access
+		updateDeduced(numberOfMillsDirty);
 
 		// during setting phase, the total number of missing stones must be at least the number of present on the field
 		if (curPlayer.numStonesMissing + oppPlayer.numStonesMissing < curPlayer.numberOfMills + oppPlayer.numberOfMills) return false;
 
-		// if current player set 9 stones, then it cannot be setting phase any more
-		if (curPlayer.numStones + curPlayer.numStonesMissing >= 9) return false;
-		if (oppPlayer.numStones + oppPlayer.numStonesMissing >  9) return false;
-
 		// each missing stone of a player must correspond to a mill of the other player on the field or a former mill, which has already been destroyed.
 		// each destroyed mill of a player, requires a missing stone of that player. 
 		if (curPlayer.numStonesMissing > oppPlayer.numberOfMills + oppPlayer.numStonesMissing) return false;
@@ -795,10 +1009,30 @@ bool fieldStruct_variables::isIntegrityOk() const
 
 		// if there are stones missing, then at least one player must have mills
 		if (curPlayer.numStonesMissing + oppPlayer.numStonesMissing > 0 && (curPlayer.numberOfMills + oppPlayer.numberOfMills) == 0) return false;
+	}
+
+	if (level == validationLevel::cheap) return true;
+
+	if (settingPhase) {
+
+		// if all stones have been set, then it cannot be the setting phase anymore
+		if (getNumStonesSet() >= 2 * numStonesPerPlayer) {
+			return false;
+		}
+
+		// if current player already set all stones, then it cannot be setting phase any more
+		if (curPlayer.numStones >= numStonesPerPlayer) return false;
+
+		// if there are too many stones missing, the situation is invalid
+		if (curPlayer.numStonesMissing + oppPlayer.numStonesMissing > 2*numStonesPerPlayer - curPlayer.numStones - oppPlayer.numStones) return false;
+
+		// if current player set all stones, then it cannot be setting phase any more
+		if (curPlayer.numStones + curPlayer.numStonesMissing >= numStonesPerPlayer) return false;
+		if (oppPlayer.numStones + oppPlayer.numStonesMissing >  numStonesPerPlayer) return false;
 
 		// if next move would be in moving phase then game must not be lost
-		if (curPlayer.numStonesSet >= 8 && curPlayer.numStones < 2) return false;
-		if (oppPlayer.numStonesSet >= 9 && oppPlayer.numStones < 3) return false;
+		if (curPlayer.numStonesSet >= numStonesPerPlayer - 1 && curPlayer.numStones < 2) return false;
+		if (oppPlayer.numStonesSet >= numStonesPerPlayer     && oppPlayer.numStones < 3) return false;
 
 		// Check consistency of number of stones on field with the number of mills
 		// number of stones set might be equal, or opponent might be one stone ahead
@@ -816,8 +1050,9 @@ bool fieldStruct_variables::isIntegrityOk() const
 		// each player must have at least 2 stones
 		if (curPlayer.numStones < 2 || oppPlayer.numStones < 2) return false;
 		
-		if (gameHasFinished) {
+		if (hasGameFinished()) {
 			// if game is finished then the opponent must have a mill
+			updateDeduced(numberOfMillsDirty | curPlayerMovesDirty);
 			if (curPlayer.numStones < 3 && oppPlayer.numberOfMills == 0) return false;
 			// or current player is immobilized
 			if (curPlayer.numPossibleMoves && curPlayer.numStones >= 3) return false;
@@ -835,137 +1070,229 @@ bool fieldStruct_variables::isIntegrityOk() const
 // Name: getPossibilities()
 // Desc: Returns the possible moves for the current player 
 //-----------------------------------------------------------------------------
-void fieldStruct_forward::getPossibilities(std::vector<moveInfo::possibilityId>& possibilityIds) const
+template <class boardTopology>
+void fieldStructOf_forward<boardTopology>::getPossibilities(std::vector<moveInfo::possibilityId>& possibilityIds) const
+{
+	// locals
+	possibilityArray	buffer;
+	unsigned int		numPossibilities = getPossibilities(buffer);
+
+	// the vector keeps its capacity, so no memory is allocated once it has grown
+	possibilityIds.assign(buffer.begin(), buffer.begin() + numPossibilities);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getPossibilities()
+// Desc: Writes the possible moves for the current player into a fixed-capacity buffer and returns their number.
+//       No memory is allocated.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getPossibilities(possibilityArray& possibilityIds) const
+{
+	return getPossibilities(possibilityIds, removalMode == stoneRemoval::separatePly);
+}
+
+//-----------------------------------------------------------------------------
+// Name: getPossibilities()
+// Desc: Writes the possible moves into the buffer. If 'separateRemoval' is true, a move closing a mill is generated without the stone removal.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getPossibilities(possibilityArray& possibilityIds, bool separateRemoval) const
 {
+	// the hash key is not needed to generate the moves
+	updateDeduced(allDirty & ~hashDirty);
+
 	// When game has ended of course nothing happens any more
-	if (gameHasFinished || !isIntegrityOk()) {
-		possibilityIds.clear();
+	if (gameHasFinished) {
+		return 0;
+	// the state before closing the mill has already been checked
+	} else if (removalPending) {
+		return getPossPendingRemoval(possibilityIds);
+	} else if (!isIntegrityOk(validation)) {
+		return 0;
 	// look what is to do
+	} else if (settingPhase) {
+		return getPossSettingPhase	(possibilityIds, separateRemoval);
 	} else {
-			 if (settingPhase)			getPossSettingPhase	(possibilityIds);
-		else							getPossNormalMove	(possibilityIds);
+		return getPossNormalMove	(possibilityIds, separateRemoval);
 	}
 }
 
+//-----------------------------------------------------------------------------
+// Name: getSuccessors()
+// Desc: Writes every state reachable by a single move together with the corresponding possibility id into a buffer 
+//       and returns their number. The order is the same as the one of getPossibilities().
+//       In contrast to calling move() and undo() for each possibility, only the bit boards of the players are changed.
+//       If a stone removal is pending, the successors are the states after each possible removal, thus the opponent is on turn as well.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getSuccessors(successorArray& successors) const
+{
+	// locals
+	possibilityArray	possibilityIds;
+	unsigned int		numPossibilities	= getPossibilities(possibilityIds, false);
+
+	// the setting phase ends with the last stone set. a pending stone removal follows the stone set, which already updated the phase.
+	const bool			settingPhaseAfterMove	= settingPhase && (removalPending || curPlayer.numStonesSet + 1 + oppPlayer.numStonesSet < 2 * numStonesPerPlayer);
+
+	for (unsigned int i = 0; i < numPossibilities; i++) {
+
+		// locals
+		const packedMove	move					= packedMove{possibilityIds[i]};
+		bitBoard			movingPlayerStones		= curPlayer.stones;
+		bitBoard			otherPlayerStones		= oppPlayer.stones;
+		unsigned int		otherPlayerNumMissing	= oppPlayer.numStonesMissing;
+
+		// apply the move, which has already been done if only the stone removal is pending
+		if (!removalPending) {
+			if (!settingPhase) movingPlayerStones &= ~squareMask(move.from());
+			movingPlayerStones |= squareMask(move.to());
+		}
+
+		// remove the stone of the opponent
+		if (move.removeStone() < size) {
+			otherPlayerStones &= ~squareMask(move.removeStone());
+			otherPlayerNumMissing++;
+		}
+
+		// the opponent is on turn in the child
+		successors[i].possibilityId	= possibilityIds[i];
+		successors[i].state			= packedCore{otherPlayerStones, movingPlayerStones, otherPlayerNumMissing, curPlayer.numStonesMissing, settingPhaseAfterMove, oppPlayer.id};
+	}
+
+	return numPossibilities;
+}
+
 //-----------------------------------------------------------------------------
 // Name: getPossSettingPhase()
 // Desc: Helper function to get the possible moves in the setting phase 
 //-----------------------------------------------------------------------------
-void fieldStruct_forward::getPossSettingPhase(vector<moveInfo::possibilityId>& possibilityIds) const
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getPossSettingPhase(possibilityArray& possibilityIds, bool separateRemoval) const
 {
 	// locals
 	fieldPos 			to;
 	unsigned int 		numberOfMillsBeeingClosed;
-	vector<fieldPos> 	removableStones;
-
-	// get all removable stones
-	getPossStoneRemove(removableStones);
-
-	// clear possibilities
-	possibilityIds.clear();
+	unsigned int		numPossibilities	= 0;
+	const bitBoard		removableStones 	= getPossStoneRemove();
 
 	// possibilities with cut off
-	for (to=0; to<size; to++) {
+	for (bitBoard freeSquares = getFreeSquares(); freeSquares; ) {
 
 		// move possible ?
-		if (field[to] != playerId::squareIsFree) continue;
+		to = popSquare(freeSquares);
 
 		// check if a mill is beeing closed
-		numberOfMillsBeeingClosed = wouldMillBeClosed(fieldStruct::size, to);
+		numberOfMillsBeeingClosed = wouldMillBeClosed(size, to);
 
-		// if a mill is closed, generate moves with stone removal
 		// don't allow to close two mills at once
+		if (!rules::closeTwoMillsAtOnce && numberOfMillsBeeingClosed > 1) continue;
+
+		// if a mill is closed, generate moves with stone removal
 		// don't allow to close a mill, although no stone can be removed from the opponent
-		if (numberOfMillsBeeingClosed == 1 && removableStones.size()) {
-			for (fieldPos removePos : removableStones) {
-				possibilityIds.push_back(moveInfo{size, to, removePos}.getId());
+		if (numberOfMillsBeeingClosed && removableStones && separateRemoval) {
+			possibilityIds[numPossibilities++] = moveInfo{size, to, size}.getId();
+		} else if (numberOfMillsBeeingClosed && removableStones) {
+			for (bitBoard removable = removableStones; removable; ) {
+				possibilityIds[numPossibilities++] = moveInfo{size, to, popSquare(removable)}.getId();
 			}
 		// no mill closed, generate move without stone removal
 		} else if (numberOfMillsBeeingClosed == 0) {
-			possibilityIds.push_back(moveInfo{size, to, size}.getId());
+			possibilityIds[numPossibilities++] = moveInfo{size, to, size}.getId();
 		}
 	}
+
+	assert(numPossibilities <= maxNumPosMoves);
+	return numPossibilities;
 }
 
 //-----------------------------------------------------------------------------
 // Name: getPossNormalMove()
 // Desc: Helper function to get the possible moves in the normal phase
 //-----------------------------------------------------------------------------
-void fieldStruct_forward::getPossNormalMove(vector<unsigned int>& possibilityIds) const
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getPossNormalMove(possibilityArray& possibilityIds, bool separateRemoval) const
 {
 	// locals
-	fieldPos			from, to, dir, removePos;
-	vector<fieldPos> 	removableStones;
-	
-	possibilityIds.clear();
-
-	// get all removable stones
-	getPossStoneRemove(removableStones);
+	fieldPos			from, to, dir;
+	unsigned int		numPossibilities	= 0;
+	const bitBoard		freeSquares			= getFreeSquares();
+	const bitBoard		removableStones		= getPossStoneRemove();
 
 	// if he is not allowed to jump
-	if (curPlayer.numStones > 3) {
+	if (movesAlongLines(curPlayer.numStones)) {
 
-		for (from=0; from < size; from++) { for (dir=0; dir<4; dir++) {
+		for (bitBoard stones = curPlayer.stones; stones; ) { from = popSquare(stones); for (dir=0; dir<connectedSquare[from].size(); dir++) {
 
 			// destination 
 			to = connectedSquare[from][dir];
 
 			// move possible ?
-			if (to < size && field[from] == curPlayer.id && field[to] == playerId::squareIsFree) {
+			if (to < size && (freeSquares & squareMask(to))) {
 
-				// if a mill is closed, generate moves with stone removal
-				if (wouldMillBeClosed(from, to) && !removableStones.empty()) {
-					for (fieldPos removePos : removableStones) {
-						possibilityIds.push_back(moveInfo{from, to, removePos}.getId());
+				// if a mill is closed, generate moves with stone removal, unless the removal is a separate ply
+				if (wouldMillBeClosed(from, to) && removableStones && !separateRemoval) {
+					for (bitBoard removable = removableStones; removable; ) {
+						possibilityIds[numPossibilities++] = moveInfo{from, to, popSquare(removable)}.getId();
 					}
 				// no mill closed, generate move without stone removal
 				} else {
-					possibilityIds.push_back(moveInfo{from, to, size}.getId());
+					possibilityIds[numPossibilities++] = moveInfo{from, to, size}.getId();
 				}
 	
 	// current player is allowed to jump
-	}}}} else if (curPlayer.numStones == 3) {
-
-		for (from=0; from < size; from++) { for (to=0; to < size; to++) {
+	}}}} else if (canJump(curPlayer.numStones)) {
 
-			// move possible ?
-			if (field[from] == curPlayer.id &&  field[to] == playerId::squareIsFree) {
+		for (bitBoard stones = curPlayer.stones; stones; ) { from = popSquare(stones); for (bitBoard destinations = freeSquares; destinations; ) { to = popSquare(destinations);
 
-				// if a mill is closed, generate moves with stone removal
-				if (wouldMillBeClosed(from, to) && !removableStones.empty()) {
-					for (fieldPos removePos : removableStones) {
-						possibilityIds.push_back(moveInfo{from, to, removePos}.getId());
-					}
-				// no mill closed, generate move without stone removal
-				} else {
-					possibilityIds.push_back(moveInfo{from, to, size}.getId());
+			// if a mill is closed, generate moves with stone removal, unless the removal is a separate ply
+			if (wouldMillBeClosed(from, to) && removableStones && !separateRemoval) {
+				for (bitBoard removable = removableStones; removable; ) {
+					possibilityIds[numPossibilities++] = moveInfo{from, to, popSquare(removable)}.getId();
 				}
-	}}}} else {
+			// no mill closed, generate move without stone removal
+			} else {
+				possibilityIds[numPossibilities++] = moveInfo{from, to, size}.getId();
+			}
+	}}} else {
 		// no possible moves
 	}
 
-	assert(possibilityIds.size() < fieldStruct::maxNumPosMoves);
+	assert(numPossibilities <= maxNumPosMoves);
+	return numPossibilities;
 }
 
 //-----------------------------------------------------------------------------
-// Name: getPossStoneRemove()
-// Desc: Helper function to get the possible moves to remove a stone
+// Name: getPossPendingRemoval()
+// Desc: Helper function to get the possible stone removals, after a mill has been closed by the previous ply
 //-----------------------------------------------------------------------------
-void fieldStruct_forward::getPossStoneRemove(vector<fieldPos>& removableStones) const
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::getPossPendingRemoval(possibilityArray& possibilityIds) const
 {
 	// locals
-	fieldPos from;
-	
-	removableStones.clear();
+	unsigned int		numPossibilities	= 0;
 
-	// possibilities with cut off
-	for (from=0; from<size; from++) {
+	for (bitBoard removable = getPossStoneRemove(); removable; ) {
+		possibilityIds[numPossibilities++] = moveInfo{size, size, popSquare(removable)}.getId();
+	}
+	return numPossibilities;
+}
 
-		// move possible ?
-		if (canStoneBeRemoved(from)) {
-			removableStones.push_back(from);
-		}
+//-----------------------------------------------------------------------------
+// Name: getPossStoneRemove()
+// Desc: Helper function returning the mask of the opponent stones, which could be removed
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+bitBoard fieldStructOf_forward<boardTopology>::getPossStoneRemove() const
+{
+	// locals
+	bitBoard removableStones = 0;
+
+	for (bitBoard stones = oppPlayer.stones; stones; ) {
+		fieldPos from = popSquare(stones);
+		if (canStoneBeRemoved(from)) removableStones |= squareMask(from);
 	}
+	return removableStones;
 }
 
 //-----------------------------------------------------------------------------
@@ -973,13 +1300,17 @@ void fieldStruct_forward::getPossStoneRemove(vector<fieldPos>& removableStones)
 // Desc: Checks if a mill would be closed by moving from 'from' to 'to'
 //       Does not return true if the stone is already part of a mill at 'from'.
 //-----------------------------------------------------------------------------
-unsigned int fieldStruct_forward::wouldMillBeClosed(fieldPos from, fieldPos to) const
+template <class boardTopology>
+unsigned int fieldStructOf_forward<boardTopology>::wouldMillBeClosed(fieldPos from, fieldPos to) const
 {
-	unsigned int numberOfMillsBeingClosed = 0;
+	// locals
+	const bitBoard stonesAfterMove = (curPlayer.stones & ~squareMask(from)) | squareMask(to);
+	unsigned int   numberOfMillsBeingClosed = 0;
 
 	// check if a mill is being closed
-	if (curPlayer.id == field[neighbour[to][0][0]] && curPlayer.id == field[neighbour[to][0][1]] && neighbour[to][0][0] != from && neighbour[to][0][1] != from) numberOfMillsBeingClosed++;
-	if (curPlayer.id == field[neighbour[to][1][0]] && curPlayer.id == field[neighbour[to][1][1]] && neighbour[to][1][0] != from && neighbour[to][1][1] != from) numberOfMillsBeingClosed++;
+	for (bitBoard mill : millsOfSquare[to]) {
+		if ((stonesAfterMove & mill) == mill) numberOfMillsBeingClosed++;
+	}
 
 	// return true if a mill would be closed
 	return numberOfMillsBeingClosed;
@@ -989,121 +1320,46 @@ unsigned int fieldStruct_forward::wouldMillBeClosed(fieldPos from, fieldPos to)
 // Name: canStoneBeRemoved()
 // Desc: Checks if a stone can be removed
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::canStoneBeRemoved(fieldPos pos) const
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::canStoneBeRemoved(fieldPos pos) const
 {
 	// Check if the position is valid
 	if (pos >= size) return false;
 
 	// Check if the stone belongs to the opponent
-	if (field[pos] != oppPlayer.id) return false;
+	if (!(oppPlayer.stones & squareMask(pos))) return false;
 
 	// if stone is not part of a mill then it can be removed
 	if (!stonePartOfMill[pos]) return true;
 
 	// do not allow to remove a stone belonging to two mills
-	if (stonePartOfMill[pos] > 1) return false;
+	if (!rules::removeFromTwoMills && stonePartOfMill[pos] > 1) return false;
+
+	// stones of mills are never removed
+	if (!rules::removeFromMillIfOnlyMills) return false;
 
 	// if stone is part of a mill then it can only be removed if the opponent has no "free" stones
 	if (stonePartOfMill[pos] > 0 && oppPlayer.hasOnlyMills) return true;
 
 	// if this is the last to be set during the setting phase, then it can be removed
-	if (oppPlayer.hasOnlyMills && getNumStonesSet() == 17) return true;
+	if (oppPlayer.hasOnlyMills && getNumStonesSet() == 2 * numStonesPerPlayer - 1) return true;
 
 	// otherwise the stone cannot be removed
 	return false;
 }
 
-//-----------------------------------------------------------------------------
-// Name: setWarning()
-// Desc: 
-//-----------------------------------------------------------------------------
-void fieldStruct_forward::updateStonePartOfMill(fieldPos stoneOne, fieldPos stoneTwo, fieldPos stoneThree, playerId actingPlayer)
-{
-	// if all 3 fields are occupied by current player than he closed a mill
-	if (field[stoneOne] == actingPlayer && field[stoneTwo] == actingPlayer && field[stoneThree] == actingPlayer) {
-		stonePartOfMill[stoneOne  ]++;
-		stonePartOfMill[stoneTwo  ]++;
-		stonePartOfMill[stoneThree]++;
-	}
-
-	// is a mill destroyed ?
-	if (stonePartOfMill[stoneOne] && stonePartOfMill[stoneTwo] && stonePartOfMill[stoneThree]
-	 && field[stoneOne] == playerId::squareIsFree && field[stoneTwo] == actingPlayer && field[stoneThree] == actingPlayer) {
-		stonePartOfMill[stoneOne  ]--;
-		stonePartOfMill[stoneTwo  ]--;
-		stonePartOfMill[stoneThree]--;
-	}
-}
-
-//-----------------------------------------------------------------------------
-// Name: updateWarning()
-// Desc: Updates 'stonePartOfMill'
-//-----------------------------------------------------------------------------
-void fieldStruct_forward::updateWarning(fieldPos firstStone, fieldPos secondStone, playerId actingPlayer)
-{
-	if (firstStone  < size) updateStonePartOfMill(firstStone,  neighbour[firstStone][0][0],  neighbour[firstStone][0][1], actingPlayer);
-	if (firstStone  < size) updateStonePartOfMill(firstStone,  neighbour[firstStone][1][0],  neighbour[firstStone][1][1], actingPlayer);
-	if (secondStone < size) updateStonePartOfMill(secondStone, neighbour[secondStone][0][0], neighbour[secondStone][0][1], actingPlayer);
-	if (secondStone < size) updateStonePartOfMill(secondStone, neighbour[secondStone][1][0], neighbour[secondStone][1][1], actingPlayer);
-}
-
-//-----------------------------------------------------------------------------
-// Name: updatePossibleMoves()
-// Desc: Updates the number of possible moves for each player
-//-----------------------------------------------------------------------------
-void fieldStruct_forward::updatePossibleMoves(fieldPos stone, playerStruct& stoneOwner, bool stoneRemoved, fieldPos ignoreStone)
-{
-	// locals
-	fieldPos	neighbor, direction;
-
-	// look into every direction
-	for (direction=0; direction<4; direction++) {
-
-		neighbor = connectedSquare[stone][direction];
-
-		// neighbor must exist
-		if (neighbor < size) {
-
-			// relevant when moving from one square to another connected square
-			if (ignoreStone == neighbor) continue;
-
-			// if there is no neighbour stone than it only affects the actual stone
-			if (field[neighbor] == playerId::squareIsFree) {
-			
-				if (stoneRemoved)	stoneOwner.numPossibleMoves--;
-				else				stoneOwner.numPossibleMoves++;
-			
-			// if there is a neighbour stone than it effects only this one
-			} else if (field[neighbor] == curPlayer.id) {
-				
-				if (stoneRemoved)	curPlayer.numPossibleMoves++;
-				else				curPlayer.numPossibleMoves--;
-
-			} else {
-				
-				if (stoneRemoved)	oppPlayer.numPossibleMoves++;
-				else				oppPlayer.numPossibleMoves--;
-			}
-	}}
-
-	// only 3 stones resting
-	if (curPlayer.numStones == 3 && !settingPhase) curPlayer.numPossibleMoves = curPlayer.numStones * (size - curPlayer.numStones - oppPlayer.numStones);
-	if (oppPlayer.numStones == 3 && !settingPhase) oppPlayer.numPossibleMoves = oppPlayer.numStones * (size - curPlayer.numStones - oppPlayer.numStones);
-	if (curPlayer.numStones  < 3) curPlayer.numPossibleMoves = 0;
-	if (oppPlayer.numStones  < 3) oppPlayer.numPossibleMoves = 0;
-}
-
 //-----------------------------------------------------------------------------
 // Name: setStone()
 // Desc: Performs a move in the setting phase 
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::setStone(const moveInfo& move, backupStruct& backup)
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::setStone(const moveInfo& move, backupStruct& backup)
 {
 	// parameter ok ?
 	if (move.to >= size) return false;
 
 	// is destination free ?
-	if (field[move.to] != playerId::squareIsFree) return false;
+	if (!(getFreeSquares() & squareMask(move.to))) return false;
 
 	// check if removal of stone is correct
 	if (move.removeStone < size) {
@@ -1111,35 +1367,21 @@ bool fieldStruct_forward::setStone(const moveInfo& move, backupStruct& backup)
 	}
 
 	// set stone into field
-	field[move.to]		    = curPlayer.id;
+	placeStone(move.to, curPlayer);
 	curPlayer.numStones++;
 	curPlayer.numStonesSet++;
 
 	// setting phase finished ?
-	if (curPlayer.numStonesSet + oppPlayer.numStonesSet == 18) {
+	if (curPlayer.numStonesSet + oppPlayer.numStonesSet == 2 * numStonesPerPlayer) {
 		settingPhase = false;
+		hash ^= zobristSettingPhase;
 	}
 
-	// update possible moves
-	if (settingPhase) {
-		curPlayer.numPossibleMoves--;
-		oppPlayer.numPossibleMoves--;
-	} else {
-		calcNumPossibleMoves(curPlayer);
-		calcNumPossibleMoves(oppPlayer);
-	}
-	
-	// update warnings
-	updateWarning(move.to, size, curPlayer.id);
-
 	// handle stone removal if a mill was closed
 	if (move.removeStone < size) {
 		removeStone(move, backup);
 	}
 
-	// calculate number of mills
-	calcNumberOfMills();
-
 	// everything is ok
 	return true;	
 }
@@ -1148,13 +1390,14 @@ bool fieldStruct_forward::setStone(const moveInfo& move, backupStruct& backup)
 // Name: normalMove()
 // Desc: Performs a normal move 
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::normalMove(const moveInfo& move, backupStruct& backup)
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::normalMove(const moveInfo& move, backupStruct& backup)
 {
 	// check if move is possible
 	if (move.from 			>= size) 					return false;
 	if (move.to   			>= size) 					return false;
-	if (field[move.from] 	!= curPlayer.id) 			return false;
-	if (field[move.to]   	!= playerId::squareIsFree) 	return false;
+	if (!(curPlayer.stones & squareMask(move.from)))	return false;
+	if (!(getFreeSquares() & squareMask(move.to)))		return false;
 
 	// check if removal of stone is correct
 	if (move.removeStone < size) {
@@ -1162,16 +1405,8 @@ bool fieldStruct_forward::normalMove(const moveInfo& move, backupStruct& backup)
 	}
 
 	// set stone into field
-	field[move.from]		= playerId::squareIsFree;
-	field[move.to]		    = curPlayer.id;
-
-	// update possible moves
-	updatePossibleMoves(move.from, curPlayer, true,  move.to);
-	updatePossibleMoves(move.to,   curPlayer, false, move.from);
-
-	// update warnings
-	updateWarning(move.from, move.to, curPlayer.id);
-	calcNumberOfMills();
+	liftStone (move.from, curPlayer);
+	placeStone(move.to,   curPlayer);
 
 	// handle stone removal if a mill was closed
 	if (move.removeStone < size) {
@@ -1186,30 +1421,16 @@ bool fieldStruct_forward::normalMove(const moveInfo& move, backupStruct& backup)
 // Name: removeStone()
 // Desc: Removes a stone from the field
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::removeStone(const moveInfo& move, backupStruct& backup) 
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::removeStone(const moveInfo& move, backupStruct& backup) 
 {
 	// check if removal of stone is correct
 	if (!canStoneBeRemoved(move.removeStone)) return false;
 
 	// remove stone
-	field[move.removeStone]		    = playerId::squareIsFree;
+	liftStone(move.removeStone, oppPlayer);
 	oppPlayer.numStones--;
-	oppPlayer.numStonesMissing++;
-	
-	// update possible moves
-	if (settingPhase) {
-		curPlayer.numPossibleMoves++;
-		oppPlayer.numPossibleMoves++;
-	} else {
-		updatePossibleMoves(move.removeStone, oppPlayer, true, size);
-	}
-
-	// update warnings
-	updateWarning(move.removeStone, size, oppPlayer.id);
-
-	// end of game ?
-	if ((oppPlayer.numStones < 3) && (!settingPhase)) 									gameHasFinished	= true;		// opponent has less than 3 stones
-	if ((!oppPlayer.numPossibleMoves) && (!settingPhase) && (oppPlayer.numStones > 3)) 	gameHasFinished = true;		// opponent has no possible moves and more than 3 stones
+	setNumStonesMissing(oppPlayer, oppPlayer.numStonesMissing + 1);
 
 	// everything is ok
 	return true;
@@ -1219,15 +1440,22 @@ bool fieldStruct_forward::removeStone(const moveInfo& move, backupStruct& backup
 // Name: move()
 // Desc: Performs a move
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::move(const moveInfo& move, backupStruct& oldState)
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::move(const moveInfo& move, backupStruct& oldState)
 {
-    // calculate place of stone
-	oldState.gameHasFinished	= gameHasFinished;										
-	oldState.curPlayer			= curPlayer;								
-	oldState.oppPlayer			= oppPlayer;
-	oldState.settingPhase		= settingPhase;									
-	oldState.stonePartOfMill	= stonePartOfMill;
-	oldState.field 				= field;
+	// the incremental updates require all deduced variables
+	updateDeduced(allDirty);
+
+    // backup the variables, which are not restored by reverting the move
+	oldState.moveDone					= false;
+	oldState.gameHasFinished			= gameHasFinished;										
+	oldState.hash						= hash;
+	oldState.settingPhase				= settingPhase;									
+	oldState.curPlayerNumPossibleMoves	= curPlayer.numPossibleMoves;
+	oldState.oppPlayerNumPossibleMoves	= oppPlayer.numPossibleMoves;
+	oldState.curPlayerHasOnlyMills		= curPlayer.hasOnlyMills;
+	oldState.oppPlayerHasOnlyMills		= oppPlayer.hasOnlyMills;
+	oldState.removalPending				= removalPending;
 
 	// check if move is possible
 	if (gameHasFinished)			return false;
@@ -1237,15 +1465,39 @@ bool fieldStruct_forward::move(const moveInfo& move, backupStruct& oldState)
 
 	// move
 	bool moveResult = false;
-	if (settingPhase)	{ moveResult = setStone(move, oldState);    }
-	else				{ moveResult = normalMove(move, oldState);	}	
+	if (removalPending)		{ moveResult = move.from == size && move.to == size && move.removeStone < size && removeStone(move, oldState); }
+	else if (settingPhase)	{ moveResult = setStone(move, oldState);	}
+	else					{ moveResult = normalMove(move, oldState);	}	
 	if (!moveResult) return false;
 
-	// when opponent is unable to move than current player has won
-	if ((!oppPlayer.numPossibleMoves) && (!settingPhase) && (oppPlayer.numStones > 3)) gameHasFinished = true;
+	// remember the move for undo()
+	oldState.moveDone		= true;
+	oldState.from			= static_cast<unsigned char>(move.from);
+	oldState.to				= static_cast<unsigned char>(move.to);
+	oldState.removeStone	= static_cast<unsigned char>(move.removeStone);
+
+	// update possible moves
+	calcNumPossibleMoves(curPlayer);
+	calcNumPossibleMoves(oppPlayer);
+
+	// when the stone removal is a separate ply, the current player stays on turn after closing a mill
+	if (removalPending) {
+		removalPending	= false;
+		hash		   ^= zobristRemovalPending;
+	} else if (removalMode == stoneRemoval::separatePly && move.removeStone == size && stonePartOfMill[move.to] && getPossStoneRemove()) {
+		removalPending	= true;
+		hash		   ^= zobristRemovalPending;
+		calcHasOnlyMills();
+		return true;
+	}
+
+	// end of game ?
+	if ((move.removeStone < size) && (oppPlayer.numStones < 3) && (!settingPhase))		gameHasFinished	= true;		// opponent has less than 3 stones
+	if ((!oppPlayer.numPossibleMoves) && (!settingPhase) && movesAlongLines(oppPlayer.numStones)) 	gameHasFinished = true;		// opponent has no possible moves and is not allowed to jump
 
 	// set next player
 	std::swap(curPlayer, oppPlayer);
+	hash ^= zobristPlayerTwoToMove;
 
 	// update hasOnlyMills
 	calcHasOnlyMills();
@@ -1257,17 +1509,67 @@ bool fieldStruct_forward::move(const moveInfo& move, backupStruct& oldState)
 // Name: undo()
 // Desc: Reverts to an old state
 //-----------------------------------------------------------------------------
-bool fieldStruct_forward::undo(const backupStruct& oldState)
+template <class boardTopology>
+bool fieldStructOf_forward<boardTopology>::undo(const backupStruct& oldState)
 {
+	// nothing to do, if the move was refused
+	if (!oldState.moveDone) return true;
+
+	// the moving player is on turn again, unless the stone removal is still pending
+	if (!removalPending) {
+		std::swap(curPlayer, oppPlayer);
+	}
+
+	// put back the removed stone
+	if (oldState.removeStone < size) {
+		placeStone(oldState.removeStone, oppPlayer);
+		oppPlayer.numStones++;
+		oppPlayer.numStonesMissing--;
+	}
+
+	// revert the move itself, which is skipped if only a stone was removed
+	if (oldState.to < size) {
+		liftStone(oldState.to, curPlayer);
+		if (oldState.settingPhase) {
+			curPlayer.numStones--;
+			curPlayer.numStonesSet--;
+		} else {
+			placeStone(oldState.from, curPlayer);
+		}
+	}
+
+	// restore the remaining variables
 	gameHasFinished				= oldState.gameHasFinished;
-	curPlayer					= oldState.curPlayer;							
-	oppPlayer					= oldState.oppPlayer;							
+	hash						= oldState.hash;
 	settingPhase				= oldState.settingPhase;						
-	field 						= oldState.field;
-    stonePartOfMill	            = oldState.stonePartOfMill;
+	curPlayer.numPossibleMoves	= oldState.curPlayerNumPossibleMoves;
+	oppPlayer.numPossibleMoves	= oldState.oppPlayerNumPossibleMoves;
+	curPlayer.hasOnlyMills		= oldState.curPlayerHasOnlyMills;
+	oppPlayer.hasOnlyMills		= oldState.oppPlayerHasOnlyMills;
+	removalPending				= oldState.removalPending;
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Name: setStoneRemoval()
+// Desc: Chooses if the removal of a stone is part of the move closing the mill or a separate ply.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_forward<boardTopology>::setStoneRemoval(stoneRemoval mode)
+{
+	removalMode = mode;
+}
+
+//-----------------------------------------------------------------------------
+// Name: getStoneRemoval()
+// Desc: Returns if the removal of a stone is part of the move closing the mill or a separate ply.
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+stoneRemoval fieldStructOf_forward<boardTopology>::getStoneRemoval() const
+{
+	return removalMode;
+}
+
 #pragma endregion
 
 #pragma region fieldStruct_reverse
@@ -1276,7 +1578,25 @@ bool fieldStruct_forward::undo(const backupStruct& oldState)
 // Name: getPredecessors()
 // Desc: Returns the predecessors fields of the current field
 //-----------------------------------------------------------------------------
-void fieldStruct_reverse::getPredecessors(vector<fieldStruct::core>& predFields) const
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors(vector<core>& predFields) const
+{
+	// locals
+	vector<packedCore> packedPredFields;
+
+	getPredecessors(packedPredFields);
+	predFields.clear();
+	for (auto& predField : packedPredFields) {
+		predFields.push_back(predField.unpack());
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: getPredecessors()
+// Desc: Returns the predecessors fields of the current field in packed form
+//-----------------------------------------------------------------------------
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors(vector<packedCore>& predFields) const
 {
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // the important variables, which much be updated for the getLayerAndStateNumber function are the following ones:
@@ -1288,8 +1608,11 @@ void fieldStruct_reverse::getPredecessors(vector<fieldStruct::core>& predFields)
 
 	predFields.clear();
 
+	// the predecessors are derived incrementally from the deduced variables. only the hash key is not needed.
+	updateDeduced(allDirty & ~hashDirty);
+
 	// locals
-	fieldStruct_reverse tmpField 		= *this;
+	fieldStructOf_reverse tmpField 		= *this;
     bool 				millWasClosed 	= false;
 
 	// stone was removed
@@ -1309,7 +1632,8 @@ void fieldStruct_reverse::getPredecessors(vector<fieldStruct::core>& predFields)
 // Name: getPredecessors_settingPhase()
 // Desc: Helper function to get the predecessors in the stone setting phase
 //-----------------------------------------------------------------------------
-void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors_settingPhase(vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const
 {
 	// locals
 	unsigned int			to;
@@ -1332,18 +1656,18 @@ void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>
 		if (field.getNumStonesSet() != field.curPlayer.numStones + field.oppPlayer.numStones + field.curPlayer.numStonesMissing + field.oppPlayer.numStonesMissing) return;
 
 		// all stones must be set, to be in the moving phase
-		if (field.curPlayer.numStonesSet != fieldStruct::numStonesPerPlayer || field.oppPlayer.numStonesSet != fieldStruct::numStonesPerPlayer) return;
+		if (field.curPlayer.numStonesSet != numStonesPerPlayer || field.oppPlayer.numStonesSet != numStonesPerPlayer) return;
 	}
 
-	// stone could have been placed anywhere
-	for (to=0; to < field.size; to++) { 
+	// stone which was set must be owned by the current player, if a mill was closed
+	// otherwise, it must be owned by the opponent player
+	for (bitBoard stones = (millWasClosed ? field.curPlayer.stones : field.oppPlayer.stones); stones; ) { 
 
-		// do not allow to close two mills at once
-		if (field.stonePartOfMill[to] >= 2) continue;
+		// stone could have been placed anywhere
+		to = popSquare(stones);
 
-		// stone which was set must be owned by the current player, if a mill was closed
-		// otherwise, it must be owned by the opponent player
-		if (field.field[to] != (millWasClosed ? field.curPlayer.id : field.oppPlayer.id)) continue;
+		// do not allow to close two mills at once
+		if (!rules::closeTwoMillsAtOnce && field.stonePartOfMill[to] >= 2) continue;
 
 		// if a mill was closed so the stone must be part of a mill
 		if ( millWasClosed && field.stonePartOfMill[to] == 0) continue;
@@ -1358,12 +1682,13 @@ void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>
 			field.settingPhase 		= true;
 			field.gameHasFinished 	= false;
 
-			field.field[to] = playerId::squareIsFree;
 			if (millWasClosed) {
+				field.clearSquare(to, field.curPlayer);
 				field.curPlayer.numStones--;
 				field.curPlayer.numStonesSet--;
 				field.curPlayer.numberOfMills--;
 			} else {
+				field.clearSquare(to, field.oppPlayer);
 				field.oppPlayer.numStones--;
 				field.oppPlayer.numStonesSet--;
 				std::swap(field.curPlayer, field.oppPlayer);
@@ -1375,7 +1700,7 @@ void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>
 		// put stone back
 		{
 			if (millWasClosed) {
-				field.field[to] 			= field.curPlayer.id;
+				field.setSquare(to, field.curPlayer);
 				field.curPlayer.numberOfMills++;
 				field.curPlayer.numStonesSet++;
 				field.curPlayer.numStones++;
@@ -1383,7 +1708,7 @@ void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>
 				std::swap(field.curPlayer, field.oppPlayer);
 				field.oppPlayer.numStonesSet++;
 				field.oppPlayer.numStones++;
-				field.field[to] 			= field.oppPlayer.id;
+				field.setSquare(to, field.oppPlayer);
 			}
 
 			field.settingPhase 		= settingPhaseBackup;
@@ -1396,7 +1721,8 @@ void fieldStruct_reverse::getPredecessors_settingPhase(vector<fieldStruct::core>
 // Name: getPredecessors_normalMove()
 // Desc: Helper function to get the predecessors in the normal phase
 //-----------------------------------------------------------------------------
-void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors_normalMove(vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const
 {
 	// locals
 	unsigned int from, to, dir;
@@ -1409,12 +1735,12 @@ void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>&
     if (field.curPlayer.numStones < 3 || field.oppPlayer.numStones < 3 || 
 		(field.gameHasFinished && field.curPlayer.numPossibleMoves != 0)) return;
 
-	// test each destination
-	for (to=0; to < field.size; to++) { 
+	// stone which was moved must be owned by the current player, if a mill was closed
+	// otherwise, it must be owned by the opponent player
+	for (bitBoard stones = (millWasClosed ? field.curPlayer.stones : field.oppPlayer.stones); stones; ) { 
 
-		// stone which was moved must be owned by the current player, if a mill was closed
-		// otherwise, it must be owned by the opponent player
-		if (field.field[to] != (millWasClosed ? field.curPlayer.id : field.oppPlayer.id)) continue;
+		// test each destination
+		to = popSquare(stones);
 
 		// when stone is going to be removed than a mill must be closed
 		if ( millWasClosed && field.stonePartOfMill[to] == 0) continue;
@@ -1423,13 +1749,13 @@ void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>&
 		if (!millWasClosed && field.stonePartOfMill[to] != 0) continue;
 
 		// test each direction
-		for (dir=0; dir<4; dir++) {
+		for (dir=0; dir<field.connectedSquare[to].size(); dir++) {
 
 			// origin
 			from = field.connectedSquare[to][dir];
 
 			// move possible ?
-			if (!(from < field.size && field.field[from] == playerId::squareIsFree)) continue;
+			if (!(from < field.size && (field.getFreeSquares() & squareMask(from)))) continue;
 
 			// make move
 			{
@@ -1439,8 +1765,8 @@ void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>&
 					std::swap(field.curPlayer, field.oppPlayer);
 				}
 
-				field.field[from]      		= field.field[to];
-				field.field[to]        		= playerId::squareIsFree;
+				field.clearSquare(to,   field.curPlayer);
+				field.setSquare  (from, field.curPlayer);
 				gameHasFinishedBackup 		= field.gameHasFinished;
 				field.gameHasFinished 		= false;
 			}
@@ -1449,8 +1775,8 @@ void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>&
 
 			// undo move
 			{
-				field.field[to]        		= field.field[from];
-				field.field[from]      		= playerId::squareIsFree;
+				field.clearSquare(from, field.curPlayer);
+				field.setSquare  (to,   field.curPlayer);
 				field.gameHasFinished 		= gameHasFinishedBackup;
 
 				if (millWasClosed) {
@@ -1466,7 +1792,8 @@ void fieldStruct_reverse::getPredecessors_normalMove(vector<fieldStruct::core>&
 // Name: getPredecessors_jumpingPhase()
 // Desc: Helper function to get the predecessors in the jumping phase
 //-----------------------------------------------------------------------------
-void fieldStruct_reverse::getPredecessors_jumpingPhase(vector<fieldStruct::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors_jumpingPhase(vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const
 {
 	// locals
 	unsigned int from, to;
@@ -1477,11 +1804,11 @@ void fieldStruct_reverse::getPredecessors_jumpingPhase(vector<fieldStruct::core>
 	// both players must have at least 3 stones and game must not be finished yet
     if (field.curPlayer.numStones < 3 || field.oppPlayer.numStones < 3 || field.gameHasFinished) return;
 
-	// test each destination
-	for (to=0; to < field.size; to++) { 
+	// when stone must be removed than current player closed a mill, otherwise the opponent did a common spring move
+	for (bitBoard stones = (millWasClosed ? field.curPlayer.stones : field.oppPlayer.stones); stones; ) { 
 
-		// when stone must be removed than current player closed a mill, otherwise the opponent did a common spring move
-		if (field.field[to] != (millWasClosed ? field.curPlayer.id : field.oppPlayer.id)) continue;
+		// test each destination
+		to = popSquare(stones);
 
 		// when stone is going to be removed than a mill must be closed
 		if ( millWasClosed && field.stonePartOfMill[to] == 0) continue;
@@ -1489,25 +1816,18 @@ void fieldStruct_reverse::getPredecessors_jumpingPhase(vector<fieldStruct::core>
 		// when stone is part of a mill then a stone must be removed
 		if (!millWasClosed && field.stonePartOfMill[to] != 0) continue;
 
-		// test each stone origin
-		for (from=0; from<field.size; from++) {
-
-			// move possible ?
-			{
-				if (field.field[from] != playerId::squareIsFree) continue;
-
-				// is currently player allowed to jump?
-				if (field.curPlayer.numStones > 3 &&  millWasClosed
-				||  field.oppPlayer.numStones > 3 && !millWasClosed) {
+		// test each stone origin, which must be a free square
+		// if the player is not allowed to jump, both squares must be connected
+		bitBoard origins = field.getFreeSquares();
+		if (movesAlongLines(field.curPlayer.numStones) &&  millWasClosed
+		||  movesAlongLines(field.oppPlayer.numStones) && !millWasClosed) {
+			origins &= adjacentSquares[to];
+		}
 
-					// determine moving direction
-					unsigned int movingDirection = 4;
-					for (unsigned int k=0; k<4; k++) if (field.connectedSquare[from][k] == to) movingDirection = k;
+		for (; origins; ) {
 
-					// are both squares connected ?
-					if (movingDirection == 4) continue;
-				}
-			}
+			// move possible ?
+			from = popSquare(origins);
 			
 			// make move
 			{
@@ -1517,16 +1837,16 @@ void fieldStruct_reverse::getPredecessors_jumpingPhase(vector<fieldStruct::core>
 					std::swap(field.curPlayer, field.oppPlayer);
 				}
 
-				field.field[from]  = field.field[to];
-				field.field[to]    = playerId::squareIsFree;
+				field.clearSquare(to,   field.curPlayer);
+				field.setSquare  (from, field.curPlayer);
 			}
 
 			storePredecessor(predFields, field);
 
 			// undo move
 			{
-				field.field[to]    = field.field[from];
-				field.field[from]  = playerId::squareIsFree;
+				field.clearSquare(from, field.curPlayer);
+				field.setSquare  (to,   field.curPlayer);
 
 				if (millWasClosed) {
 					field.curPlayer.numberOfMills++;
@@ -1541,15 +1861,16 @@ void fieldStruct_reverse::getPredecessors_jumpingPhase(vector<fieldStruct::core>
 // Name: getPredecessors_stoneRemove()
 // Desc: Helper function to get the predecessors in the remove phase
 //-----------------------------------------------------------------------------
-void fieldStruct_reverse::getPredecessors_stoneRemove(vector<fieldStruct::core>& predFields, fieldStruct_reverse& field) const
+template <class boardTopology>
+void fieldStructOf_reverse<boardTopology>::getPredecessors_stoneRemove(vector<packedCore>& predFields, fieldStructOf_reverse& field) const
 {
 	// locals
 	unsigned int 	from;
 	bool 			gameHasFinishedBackup;
 	unsigned int	stoneFromMillWasRemoved;
 
-    // a stone was only removed, when the current player has less than 9 stones and at least one stone missing
-    if (field.curPlayer.numStones >= 9 || field.curPlayer.numStonesMissing == 0 || field.curPlayer.numStonesSet == 0) return;
+    // a stone was only removed, when the current player has not all stones and at least one stone missing
+    if (field.curPlayer.numStones >= numStonesPerPlayer || field.curPlayer.numStonesMissing == 0 || field.curPlayer.numStonesSet == 0) return;
 
 	// at least 5 stones must be set (3 from the opponent for the mill and 2 from the current player (thereby 1 has been removed))
 	if (field.getNumStonesSet() < 5 && field.oppPlayer.numStones < 3 && field.curPlayer.numStones < 1) return;
@@ -1558,24 +1879,18 @@ void fieldStruct_reverse::getPredecessors_stoneRemove(vector<fieldStruct::core>&
 	if (!field.oppPlayer.numberOfMills) return;
 
 	// from each free position the opponent could have removed a stone from the current player
-	for (from=0; from<field.size; from++) {
+	for (bitBoard freeSquares = field.getFreeSquares(); freeSquares; ) {
 
 		// square free?
-		if (field.field[from] != playerId::squareIsFree) continue;
+		from = popSquare(freeSquares);
 
 		// stone mustn't be part of mill, except player has only mills
 		stoneFromMillWasRemoved = 0;
 		{
-			vector<fieldPos> millStones = {
-				  from, 
-				  field.neighbour[from][0][0],
-				  field.neighbour[from][0][1],
-				  field.neighbour[from][1][0],
-				  field.neighbour[from][1][1]
-				};
-			if (field.field[millStones[1]] == field.curPlayer.id && field.field[millStones[2]] == field.curPlayer.id) stoneFromMillWasRemoved++;
-			if (field.field[millStones[3]] == field.curPlayer.id && field.field[millStones[4]] == field.curPlayer.id) stoneFromMillWasRemoved++;
-			if (stoneFromMillWasRemoved && anyLonelyStone(field, from)) continue;
+			for (bitBoard mill : field.millsOfSquare[from]) {
+				if (((field.curPlayer.stones | squareMask(from)) & mill) == mill) stoneFromMillWasRemoved++;
+			}
+			if (stoneFromMillWasRemoved && (!rules::removeFromMillIfOnlyMills || anyLonelyStone(field, from))) continue;
 		}
 
 		// if stone was removed from mill, then player must have at least one stone on the board
@@ -1583,19 +1898,17 @@ void fieldStruct_reverse::getPredecessors_stoneRemove(vector<fieldStruct::core>&
 			if (field.curPlayer.numStones == 0 || field.curPlayer.numStonesSet == 0) continue;
 		}
 		// do not allow to remove a stone being part of two mills
-		if (stoneFromMillWasRemoved>1) continue;
+		if (!rules::removeFromTwoMills && stoneFromMillWasRemoved>1) continue;
 
-		// put back stone
+		// put back stone, thereby only the mills through this square are updated
 		{
 			gameHasFinishedBackup		= field.gameHasFinished;
 			field.gameHasFinished		= false;
-			field.field[from]          	= field.curPlayer.id;
+			field.placeStone(from, field.curPlayer);
 			field.curPlayer.numStones++;
 			field.curPlayer.numStonesMissing--;
 			if (stoneFromMillWasRemoved) {
-				field.curPlayer.numberOfMills += stoneFromMillWasRemoved;
 				field.curPlayer.hasOnlyMills   = true;
-				field.calcStonePartOfMill();
 			}
 			std::swap(field.curPlayer, field.oppPlayer);
 		}
@@ -1608,14 +1921,12 @@ void fieldStruct_reverse::getPredecessors_stoneRemove(vector<fieldStruct::core>&
 		// remove stone again
 		{
 			std::swap(field.curPlayer, field.oppPlayer);
-			field.field[from]          	= playerId::squareIsFree;
+			field.liftStone(from, field.curPlayer);
 			field.gameHasFinished		= gameHasFinishedBackup;
 			field.curPlayer.numStones--;
 			field.curPlayer.numStonesMissing++;
 			if (stoneFromMillWasRemoved) {
-				field.curPlayer.numberOfMills -= stoneFromMillWasRemoved;
 				field.curPlayer.hasOnlyMills   = false;
-				field.calcStonePartOfMill();
 			}
 		}
 	}
@@ -1625,16 +1936,15 @@ void fieldStruct_reverse::getPredecessors_stoneRemove(vector<fieldStruct::core>&
 // Name: storePredecessor()
 // Desc: store the current field state as a predecessor
 //---------------------------------------------------
-bool fieldStruct_reverse::storePredecessor(vector<fieldStruct_types::core>& predFields, const fieldStruct_reverse& field) const
+template <class boardTopology>
+bool fieldStructOf_reverse<boardTopology>::storePredecessor(vector<packedCore>& predFields, const fieldStructOf_reverse& field) const
 {
-	// store predecessor
-	if (field.isIntegrityOk()) {
-		predFields.push_back(field);
+	// the unmove generators are meant to guarantee a valid state by construction, except for the accounting of mills and missing stones 
+	// during the setting phase, which the cheap checks cover. as long as MuehleVerify has not shown this for all layers, the full checks are kept.
+	if (field.isIntegrityOk(predecessorValidation)) {
+		predFields.push_back(packedCore{field});
 		return true;
 	} else {
-		// TODO: The conditions should be checked within the getPredecessor functions,
-		// such that isIntegrity should not be necessary
-		// assert(false);
 		return false;
 	}
 }
@@ -1645,21 +1955,41 @@ bool fieldStruct_reverse::storePredecessor(vector<fieldStruct_types::core>& pred
 //       thereby a stone is considered lonely if it is not part of any mill.
 //		 'removedFrom' is the position of the stone that was removed from the field.
 //---------------------------------------------------
-bool fieldStruct_reverse::anyLonelyStone(const fieldStruct_reverse& field, fieldPos removedFrom) const
+template <class boardTopology>
+bool fieldStructOf_reverse<boardTopology>::anyLonelyStone(const fieldStructOf_reverse& field, fieldPos removedFrom) const
 {
-	// check every stone
-	for (fieldPos k=0; k<field.size; k++) {
+	// locals
+	bitBoard skippedSquares = squareMask(removedFrom);
 
-		// skip the current removed stone and the potential mills being closed by that stone
-		if (k == removedFrom) continue;
-		if (k == field.neighbour[removedFrom][0][1] && field.field[field.neighbour[removedFrom][0][0]] == field.curPlayer.id) continue;
-		if (k == field.neighbour[removedFrom][0][0] && field.field[field.neighbour[removedFrom][0][1]] == field.curPlayer.id) continue;
-		if (k == field.neighbour[removedFrom][1][1] && field.field[field.neighbour[removedFrom][1][0]] == field.curPlayer.id) continue;
-		if (k == field.neighbour[removedFrom][1][0] && field.field[field.neighbour[removedFrom][1][1]] == field.curPlayer.id) continue;
+	// skip the current removed stone and the potential mills being closed by that stone
+	for (const auto& line : field.neighbour[removedFrom]) {
+		if (field.curPlayer.stones & squareMask(line[0])) skippedSquares |= squareMask(line[1]);
+		if (field.curPlayer.stones & squareMask(line[1])) skippedSquares |= squareMask(line[0]);
+	}
+
+	// check every stone
+	for (bitBoard stones = field.curPlayer.stones & ~skippedSquares; stones; ) {
 
 		// check if the stone is lonely
-		if (field.field[k] == field.curPlayer.id && !field.stonePartOfMill[k]) return true;
+		if (!field.stonePartOfMill[popSquare(stones)]) return true;
 	}
 	return false;
 }
 #pragma endregion
+
+// explicit instantiation for each topology of boardTopology.h
+template class fieldStructOf_types<sixMensMorris>;
+template class fieldStructOf_variables<sixMensMorris>;
+template class fieldStructOf_forward<sixMensMorris>;
+template class fieldStructOf_reverse<sixMensMorris>;
+template class fieldStructOf<sixMensMorris>;
+template class fieldStructOf_types<nineMensMorris>;
+template class fieldStructOf_variables<nineMensMorris>;
+template class fieldStructOf_forward<nineMensMorris>;
+template class fieldStructOf_reverse<nineMensMorris>;
+template class fieldStructOf<nineMensMorris>;
+template class fieldStructOf_types<twelveMensMorris>;
+template class fieldStructOf_variables<twelveMensMorris>;
+template class fieldStructOf_forward<twelveMensMorris>;
+template class fieldStructOf_reverse<twelveMensMorris>;
+template class fieldStructOf<twelveMensMorris>;
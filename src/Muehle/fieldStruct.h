@@ -13,15 +13,38 @@
 #include <vector>
 #include <cstdlib>
 #include <array>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+
+#include "boardTopology.h"
+#include "gameRules.h"
+
+/*** Constants *****************************************************/
+
+// Default validation level of the game states, which can be chosen at build time by defining MUEHLE_VALIDATION_LEVEL
+// as 0 (none), 1 (cheap) or 2 (full). Debug builds check everything, release builds only what is not guaranteed by construction.
+#ifndef MUEHLE_VALIDATION_LEVEL
+    #ifdef NDEBUG
+        #define MUEHLE_VALIDATION_LEVEL 1
+    #else
+        #define MUEHLE_VALIDATION_LEVEL 2
+    #endif
+#endif
 
 /*** Enums *********************************************************/
 enum class 						playerId  : unsigned int				{squareIsFree = 0, playerOne = 1, playerTwo = 2,   playerOneWarning =  4, playerTwoWarning =  8, playerBothWarning =  12, invalid = 1000};
+enum class						validationLevel : unsigned int			{none = 0, cheap = 1, full = 2};
+enum class						stoneRemoval : unsigned int				{withinMove = 0, separatePly = 1};
 enum class						warningId : unsigned int 				{noWarning    = 0,                                 playerOneWarning =  4, playerTwoWarning =  8, playerBothWarning =  12, invalid = 1000};
 
+/*** Types *********************************************************/
+using 							hashKey									= std::uint64_t;		// zobrist key identifying a game state
+
 /*** Classes *********************************************************/
 
 // forward declarations
-class fieldStruct_variables;
+template <class boardTopology> class fieldStructOf_variables;
 
 // class representing a move
 class moveInfo
@@ -40,9 +63,46 @@ public:
     possibilityId               getId                           () const;
     void                        setId                           (possibilityId id);
     bool                        isSettingPhase                  () const;
-    static const moveInfo&      getMoveInfo                     (possibilityId id);
+    static moveInfo             getMoveInfo                     (possibilityId id);
 };
 
+// class representing a move packed into 16 bits. 
+// the packed value is identical to moveInfo::possibilityId, so that existing databases stay valid.
+// decoding is done by a lookup table, without any exception, and is thread-safe.
+class packedMove
+{
+public:
+    using                       packedId                        = std::uint16_t;             // type holding the packed move
+
+    static const unsigned int   numSquares                      = 25;                       // 24 squares plus one for 'no square'
+    static const unsigned int   numIds                          = numSquares * numSquares * numSquares;
+
+    packedId                    id                              = numIds - 1;               // id of the move, which is by default {24, 24, 24}
+
+    constexpr                   packedMove                      () = default;
+    constexpr explicit          packedMove                      (moveInfo::possibilityId id)                                    : id(static_cast<packedId>(id)) {}
+    constexpr                   packedMove                      (unsigned int from, unsigned int to, unsigned int removeStone)  : id(static_cast<packedId>((from * numSquares + to) * numSquares + removeStone)) {}
+
+    // getter, which require a valid id
+    constexpr bool              isValid                         () const    { return id < numIds; }
+    constexpr unsigned int      from                            () const    { return fromToTable[id / numSquares].from; }
+    constexpr unsigned int      to                              () const    { return fromToTable[id / numSquares].to; }
+    constexpr unsigned int      removeStone                     () const    { return id % numSquares; }
+    moveInfo                    toMoveInfo                      () const    { return isValid() ? moveInfo{from(), to(), removeStone()} : moveInfo{}; }
+
+private:
+    struct                      fromToPair                      { std::uint8_t from; std::uint8_t to; };
+    static const std::array<fromToPair, numSquares * numSquares> fromToTable;              // maps id / numSquares to the squares 'from' and 'to'
+};
+
+inline constexpr std::array<packedMove::fromToPair, packedMove::numSquares * packedMove::numSquares> packedMove::fromToTable = []() {
+    std::array<fromToPair, numSquares * numSquares> fromToTable{};
+    for (unsigned int i = 0; i < fromToTable.size(); i++) {
+        fromToTable[i] = fromToPair{static_cast<std::uint8_t>(i / numSquares), static_cast<std::uint8_t>(i % numSquares)};
+    }
+    return fromToTable;
+}();
+
 // class representing a player
 class playerStruct
 {
@@ -55,6 +115,7 @@ public:
     unsigned int 				numPossibleMoves                = 24;				        // Number of possible moves (setting and moving phase); does NOT include possible stone removals.
     unsigned int                numberOfMills                   = 0;                        // number of mills belonging to this player
     bool                        hasOnlyMills                    = false;                    // true if the player has only mills and no non-mill stones on the field
+    bitBoard                    stones                          = 0;                        // squares occupied by this player, kept in sync with the field array
 
     bool                        operator==                      (const playerStruct& other) const;
 
@@ -71,22 +132,46 @@ public:
     };
 };
 
-// class containing the types and constants
-class fieldStruct_types
+// class containing the types and constants of the board described by 'boardTopology' (see boardTopology.h)
+template <class boardTopology>
+class fieldStructOf_types
 {
 public:
+    // board, on which the game is played
+    using topology              = boardTopology;                                            // see boardTopology.h
+    using tables                = topologyTables<topology>;                                 // bit board tables of the topology
+    using rules                 = MUEHLE_RULES;                                             // see gameRules.h
+
 	// constants
-    static const unsigned int   maxNumPosMoves                  =  3 * 18 * 9;				// 3 stones can be moved to 18 positions, 9 stones can be removed
+	static const unsigned int	numStonesPerPlayer				=  topology::numStonesPerPlayer;	// number of stones per player
+	static const int			size							=  topology::numSquares;	// number of squares
+    // upper bounds of the possible moves: 3 stones jumping to each square not occupied by 6 stones, each stone moving along each connection,
+    // or a stone set on each square, each combined with the removal of any stone of the opponent. for nine men's morris this is 3 * 18 * 9.
+    static const unsigned int   maxNumPosMoves                  =  std::max({unsigned{3 * (size - 6)} * numStonesPerPlayer, numStonesPerPlayer * tables::maxNumAdjacentSquares * numStonesPerPlayer, unsigned{size} * numStonesPerPlayer});
+    static const unsigned int   maxNumPosMovesSeparateRemoval   =  std::max({unsigned{3 * (size - 6)},                      numStonesPerPlayer * tables::maxNumAdjacentSquares,                      unsigned{size}});  // the same, when the stone removal is a separate ply
     static const playerId 		playerBlack						=  playerId::playerOne;		// define player one as black (playerId::playerOne is used for black stones)
 	static const playerId 		playerWhite						=  playerId::playerTwo;		// ''
-	static const unsigned int	numStonesPerPlayer				=  9;						// number of stones per player
-	static const int			size							= 24;						// number of squares
 	static const int			gameDrawn						=  3;						// only a nonzero value
+    static const unsigned int   numMills                        =  tables::numMills;        // number of lines of three squares forming a mill
+    static const bitBoard       allSquares                      = (bitBoard{1} << size) - 1;// mask containing every square of the field
+
+    static_assert(size < packedMove::numSquares,    "each square and 'size' for no square must be representable by packedMove");
+    static_assert(2 * size + 10 <= 64,              "the state must fit into the 64 bits of packedCore");
+    static_assert(numStonesPerPlayer < 16,          "the number of missing stones must fit into the 4 bits of packedCore");
 
     // typedef 
     using fieldPos 				= unsigned int;                                             // type representing the position of a stone on the field
     using fieldArray            = std::array<playerId, size>;                               // type representing the field as an array of playerIds, indicating the stone on each field position
     using millArray             = std::array<unsigned int, size>;                           // type representing the mills as an array of unsigned ints, indicating the number of mills, of which this stone is part of
+    using possibilityArray      = std::array<moveInfo::possibilityId, maxNumPosMoves>;      // type representing a fixed-capacity buffer for the possible moves
+
+    // bit board helpers
+    static constexpr bitBoard   squareMask                      (fieldPos pos)      { return bitBoard{1} << pos; }
+    static fieldPos             popSquare                       (bitBoard& squares) { fieldPos pos = std::countr_zero(squares); squares &= squares - 1; return pos; }
+
+    // rule helpers
+    static constexpr bool       canJump                         (unsigned int numStones) { return rules::jumpingAllowed && numStones == rules::numStonesForJumping; }
+    static constexpr bool       movesAlongLines                 (unsigned int numStones) { return numStones >= 3 && !canJump(numStones); }
 
     // class containing the a reduced set of variables, to skip unneeded computations
     class core
@@ -94,12 +179,12 @@ public:
     public: 
         // core variables
         fieldArray              field;	                                                    // one of the values above for each field position, initialized with 'squareIsFree'
-        bool		 			settingPhase                    = true;                     // true if stonesSet < 18
+        bool		 			settingPhase                    = true;                     // true if less than 2 * numStonesPerPlayer stones have been set
         playerStruct::core      curPlayer;                                                  // pointers to the current player
         playerStruct::core      oppPlayer;                              			        // pointers to the opponent player
 
                                 core                            ();
-                                core                            (const fieldStruct_variables& vars);
+                                core                            (const fieldStructOf_variables<boardTopology>& vars);
 
         const playerStruct::core&     getCurPlayer                    () const;
         const playerStruct::core&     getOppPlayer                    () const;
@@ -107,6 +192,44 @@ public:
         bool                    inSettingPhase                  () const;
     };
 
+    // class containing the core variables packed into 64 bits, used for large buffers of states like the predecessors.
+    // the number of stones on the field is given by the occupancy masks.
+    class packedCore
+    {
+    public:
+                                packedCore                      ();
+        explicit                packedCore                      (const core& state);
+        explicit                packedCore                      (const fieldStructOf_variables<boardTopology>& vars);
+                                packedCore                      (bitBoard curPlayerStones, bitBoard oppPlayerStones, unsigned int curPlayerNumStonesMissing, unsigned int oppPlayerNumStonesMissing, bool settingPhase, playerId curPlayerId);
+
+        core                    unpack                          () const;
+        bool                    operator==                      (const packedCore& other) const { return bits == other.bits; }
+
+        // getter
+        bitBoard                getCurPlayerStones              () const { return static_cast<bitBoard>(bits & allSquares); }
+        bitBoard                getOppPlayerStones              () const { return static_cast<bitBoard>((bits >> oppStonesShift) & allSquares); }
+        playerId                getCurPlayerId                  () const { return ((bits >> curPlayerShift) & 1) ? playerId::playerTwo : playerId::playerOne; }
+        playerId                getOppPlayerId                  () const { return ((bits >> curPlayerShift) & 1) ? playerId::playerOne : playerId::playerTwo; }
+        unsigned int            getCurPlayerNumStones           () const { return std::popcount(getCurPlayerStones()); }
+        unsigned int            getOppPlayerNumStones           () const { return std::popcount(getOppPlayerStones()); }
+        unsigned int            getCurPlayerNumStonesMissing    () const { return static_cast<unsigned int>((bits >> curMissingShift) & 0xF); }
+        unsigned int            getOppPlayerNumStonesMissing    () const { return static_cast<unsigned int>((bits >> oppMissingShift) & 0xF); }
+        bool                    inSettingPhase                  () const { return (bits >> settingPhaseShift) & 1; }
+
+        // copy with other squares of the players, e.g. after applying a symmetry operation to them
+        packedCore              withStones                      (bitBoard curPlayerStones, bitBoard oppPlayerStones) const;
+
+    private:
+        // bit positions
+        static const unsigned int oppStonesShift                = size;                     // bits 0..size-1 are the squares of the current player, size..2*size-1 the ones of the opponent
+        static const unsigned int curMissingShift               = 2 * size;                 // 4 bits for the number of missing stones of each player
+        static const unsigned int oppMissingShift               = 2 * size + 4;
+        static const unsigned int settingPhaseShift             = 2 * size + 8;
+        static const unsigned int curPlayerShift                = 2 * size + 9;             // set if the current player is playerId::playerTwo
+
+        std::uint64_t           bits                            = 0;
+    };
+
 protected:
     // An alias template for a two-dimensional std::array    
     template <typename T, std::size_t Row, std::size_t Col>
@@ -118,19 +241,48 @@ protected:
 };
 
 // additional variables describing the game state
-class fieldStruct_variables : public fieldStruct_types
+template <class boardTopology>
+class fieldStructOf_variables : public fieldStructOf_types<boardTopology>
 {
-friend class fieldStruct;
+template <class> friend class fieldStructOf;
+friend class fieldStructOf_types<boardTopology>::core;
+friend class fieldStructOf_types<boardTopology>::packedCore;
+
+    // the base class depends on the topology, so that its names must be made known explicitly
+    using types                 = fieldStructOf_types<boardTopology>;
 
 public:
+    using typename types::topology;
+    using typename types::tables;
+    using typename types::fieldPos;
+    using typename types::fieldArray;
+    using typename types::millArray;
+    using typename types::core;
+    using typename types::packedCore;
+    using types::size;
+    using types::numStonesPerPlayer;
+    using types::allSquares;
+    using types::squareMask;
+    using types::popSquare;
+    using types::canJump;
+    using types::movesAlongLines;
+
 	// functions
     bool                        setSituation                    (const core& core);
+    bool                        setSituation                    (const packedCore& state);
     bool                        setSituation                    (const fieldArray& field, bool settingPhase, unsigned int totalNumStonesMissing);
 	void						reset		    				(playerId firstPlayer = playerId::playerOne);
     void                        invert                          ();
-	bool					    isIntegrityOk				    () const;
+	bool					    isIntegrityOk				    (validationLevel level = validationLevel::full) const;
 	void						print   						() const;
 
+    // validation level used by the move generators, which might be changed at run time before any calculation starts
+    static validationLevel      validation;
+
+    // validation level of the predecessors. it is full independent of 'validation', so that the calculated database does not depend on it.
+    // MuehleVerify lowers it to cheap, so that it compares the predecessors passing the cheap checks with those passing the full ones.
+    static validationLevel      predecessorValidation;
+
     // getter
     playerId                    getWinner                       () const;
     bool                        hasGameFinished                 () const;
@@ -141,59 +293,156 @@ public:
     const fieldArray&           getField                        () const;
     playerId                    getStone                        (fieldPos pos) const;
     unsigned int                isStonePartOfMill               (fieldPos pos) const;
+    bitBoard                    getFreeSquares                  () const;
+    hashKey                     getHashKey                      () const;
+    bool                        isRemovalPending                () const;
 
 protected:
    
     // more constants
-	static const Array2d<fieldPos, size, 4>             connectedSquare;		        // array containg the index of the neighbour or "size"
-	static const Array3d<fieldPos, size, 2, 2>	        neighbour;			            // array containing the two neighbours of each squares
+    static constexpr const auto&                        connectedSquare = tables::connectedSquare;  // squares connected to each square, unused entries are 'size'
+    static constexpr const auto&                        neighbour       = tables::neighbour;        // other two squares of each mill running through a square
+    static constexpr const auto&                        adjacentSquares = tables::adjacentSquares;  // mask of the squares connected to each square
+    static constexpr const auto&                        millsOfSquare   = tables::millsOfSquare;    // mask of the mills running through each square
+    static constexpr const auto&                        mills           = tables::mills;            // mask of every mill on the field
+    using zobristSquareArray    = std::array<std::array<hashKey, size>, 2>;
+    using zobristMissingArray   = std::array<std::array<hashKey, numStonesPerPlayer + 1>, 2>;
+    static const zobristSquareArray                     zobristSquare;                  // random key for each player and square
+    static const zobristMissingArray                    zobristMissing;                 // random key for each player and number of missing stones
+    static const hashKey                                zobristSettingPhase;            // random key xor'ed while in setting phase
+    static const hashKey                                zobristPlayerTwoToMove;         // random key xor'ed while playerTwo is on turn
+    static const hashKey                                zobristRemovalPending;          // random key xor'ed while a stone removal is pending
 
     // core variables
 	fieldArray                  field;	                                                // one of the values above for each field position, initialized with 'squareIsFree'
-    bool		 				settingPhase                    = true;                 // true if stonesSet < 18
-
-    // deduced variables
-	millArray               	stonePartOfMill;			                            // the number of mills, of which this stone is part of
-    playerStruct                curPlayer;                                              // pointers to the current player
-    playerStruct                oppPlayer;                              			    // pointers to the opponent player
-    bool				        gameHasFinished                 = false;				// someone has won or current field is full
+    bool		 				settingPhase                    = true;                 // true if less than 2 * numStonesPerPlayer stones have been set
+    bool                        removalPending                  = false;                // true if the current player closed a mill and has to remove a stone in a separate ply
+
+    // deduced variables, which are calculated on first access after setSituation()
+	mutable millArray           stonePartOfMill;			                            // the number of mills, of which this stone is part of
+    mutable playerStruct        curPlayer;                                              // pointers to the current player
+    mutable playerStruct        oppPlayer;                              			    // pointers to the opponent player
+    mutable bool			    gameHasFinished                 = false;				// someone has won or current field is full
+    mutable hashKey             hash                            = 0;                    // zobrist key of field, missing stones, setting phase and player to move
+
+    // flags marking the deduced variables, which are not up to date
+    enum                        dirtyFlag : unsigned int        { numberOfMillsDirty = 1, stonePartOfMillDirty = 2, hasOnlyMillsDirty = 4, curPlayerMovesDirty = 8, oppPlayerMovesDirty = 16, winnerDirty = 32, hashDirty = 64, allDirty = 127 };
+    mutable unsigned int        dirty                           = 0;                    // combination of the flags above
+    void                        updateDeduced                   (unsigned int flags) const { if (dirty & flags) calcDeduced(dirty & flags); }
+    void                        calcDeduced                     (unsigned int flags) const;
 
     // helper functions
 	char						getCharFromStone				(playerId stone) const;
-	static void					setConnection					(Array2d<fieldPos, size, 4>& connectedSquare, fieldPos index, int firstDirection, int secondDirection, int thirdDirection, int fourthDirection);
-	static void					setNeighbour					(Array3d<fieldPos, size, 2, 2>& neighbour, fieldPos index, fieldPos firstNeighbour0, fieldPos secondNeighbour0, fieldPos firstNeighbour1, fieldPos secondNeighbour1);
-    void				        setStonePartOfMill				(fieldPos stone, fieldPos firstNeighbour, fieldPos secondNeighbour);
+    void                        setSquare                       (fieldPos pos, playerStruct& owner);
+    void                        clearSquare                     (fieldPos pos, playerStruct& owner);
+    void                        placeStone                      (fieldPos pos, playerStruct& owner);
+    void                        liftStone                       (fieldPos pos, playerStruct& owner);
+    void                        updateMill                      (bitBoard mill, playerStruct& owner, bool closed);
     void				        calcNumPossibleMoves			(playerStruct& player) const;
-    void                        calcStonePartOfMill             ();
-    void                        calcHasOnlyMills                ();
-    void                        calcNumberOfMills               ();
+    void                        calcStoneMasks                  ();
+    void                        calcHashKey                     () const;
+    void                        setNumStonesMissing             (playerStruct& player, unsigned int numStonesMissing);
+    static unsigned int         getPlayerIndex                  (playerId id);
+    void                        calcStonePartOfMill             () const;
+    void                        calcHasOnlyMills                () const;
+    void                        calcNumberOfMills               () const;
     void                        calcNumStones                   ();
     void                        calcNumStonesSet                (unsigned int totalNumStonesMissing);
 };
 
-// functions related to move and undo of stones
-class fieldStruct_forward : virtual public fieldStruct_variables
+// functions related to move and undo of stones.
+// the classes are stacked without virtual inheritance (variables -> forward -> reverse -> fieldStruct), so that the state is accessed directly.
+template <class boardTopology>
+class fieldStructOf_forward : public fieldStructOf_variables<boardTopology>
 {
+    // the base class depends on the topology, so that its names must be made known explicitly
+    using variables             = fieldStructOf_variables<boardTopology>;
+
 public:
-    // structure to save the backup of the field
+    using typename variables::rules;
+    using typename variables::fieldPos;
+    using typename variables::possibilityArray;
+    using typename variables::packedCore;
+    using variables::size;
+    using variables::numStonesPerPlayer;
+    using variables::maxNumPosMoves;
+    using variables::squareMask;
+    using variables::popSquare;
+    using variables::canJump;
+    using variables::movesAlongLines;
+    using variables::validation;
+    using variables::isIntegrityOk;
+    using variables::getFreeSquares;
+    using variables::getNumStonesSet;
+
+    // structure to save the backup of the field. 
+    // only the move itself and the variables, which cannot be recalculated cheaply, are stored.
     struct backupStruct
     {
-        fieldArray              field;
-        millArray               stonePartOfMill;
-        unsigned int		    stonesSet;
+        hashKey                 hash;                                                   // zobrist key before the move
+        unsigned int		    curPlayerNumPossibleMoves;                              // numPossibleMoves of the moving player
+        unsigned int		    oppPlayerNumPossibleMoves;                              // numPossibleMoves of the opponent
+        unsigned char           from;                                                   // squares of the move, which has been performed
+        unsigned char           to;                                                     // ''
+        unsigned char           removeStone;                                            // ''
+        bool                    moveDone;                                               // false if the move was refused, so that undo() has nothing to do
         bool				    settingPhase;
         bool				    gameHasFinished;
-        unsigned int		    stoneMustBeRemoved;
-        playerStruct		    curPlayer;
-        playerStruct		    oppPlayer;
+        bool                    curPlayerHasOnlyMills;                                  // hasOnlyMills of the moving player
+        bool                    oppPlayerHasOnlyMills;                                  // hasOnlyMills of the opponent
+        bool                    removalPending;                                         // true if the move was the removal of a stone as separate ply
     };
 
+    // structure representing a state reachable by a single move. the state is packed, so that it can be passed on to the state addressing directly.
+    struct successorStruct
+    {
+        moveInfo::possibilityId possibilityId;                                          // move leading to the state
+        packedCore              state;                                                  // state after the move, thus the opponent is on turn
+    };
+    using successorArray        = std::array<successorStruct, maxNumPosMoves>;          // type representing a fixed-capacity buffer for the successors
+
     // move functions
     bool                        move                            (const moveInfo& move, backupStruct& oldState);
     bool                        undo                            (                const backupStruct& oldState);
 
+    // setter
+    void                        setStoneRemoval                 (stoneRemoval mode);
+
     // getter
     void					    getPossibilities				(std::vector<moveInfo::possibilityId>& possibilityIds) const;
+    unsigned int			    getPossibilities				(possibilityArray& possibilityIds) const;
+    unsigned int			    getSuccessors   				(successorArray& successors) const;
+    stoneRemoval                getStoneRemoval                 () const;
+    bitBoard			        getPossStoneRemove				() const;
+
+protected:
+    using variables::connectedSquare;
+    using variables::millsOfSquare;
+    using variables::zobristSettingPhase;
+    using variables::zobristPlayerTwoToMove;
+    using variables::zobristRemovalPending;
+    using variables::field;
+    using variables::settingPhase;
+    using variables::removalPending;
+    using variables::stonePartOfMill;
+    using variables::curPlayer;
+    using variables::oppPlayer;
+    using variables::gameHasFinished;
+    using variables::hash;
+    using variables::hashDirty;
+    using variables::allDirty;
+    using variables::updateDeduced;
+    using variables::placeStone;
+    using variables::liftStone;
+    using variables::calcNumPossibleMoves;
+    using variables::setNumStonesMissing;
+    using variables::calcHasOnlyMills;
+
+    // With stoneRemoval::separatePly a move closing a mill is generated only once without a stone removal. The current player stays on turn 
+    // and removes the stone in an own ply, whose move is {size, size, removeStone}. getSuccessors(), getPredecessors() and the core variants 
+    // always consider the stone removal as part of the move, so that they are not affected by the mode. If a removal is pending nevertheless,
+    // getSuccessors() yields the states after each possible removal.
+    stoneRemoval                removalMode                     = stoneRemoval::withinMove;
 
 private:
 
@@ -203,54 +452,112 @@ private:
     bool			            removeStone						(const moveInfo& move, backupStruct& backup);
     
     // get possibilities
-    void				        getPossSettingPhase				(std::vector<moveInfo::possibilityId>& possibilityIds) const;
-    void				        getPossNormalMove				(std::vector<moveInfo::possibilityId>& possibilityIds) const;
-    void				        getPossStoneRemove				(std::vector<fieldPos>& removableStones) const;
+    unsigned int			    getPossibilities				(possibilityArray& possibilityIds, bool separateRemoval) const;
+    unsigned int		        getPossSettingPhase				(possibilityArray& possibilityIds, bool separateRemoval) const;
+    unsigned int		        getPossNormalMove				(possibilityArray& possibilityIds, bool separateRemoval) const;
+    unsigned int		        getPossPendingRemoval			(possibilityArray& possibilityIds) const;
     unsigned int                wouldMillBeClosed               (fieldPos from, fieldPos to) const;
     bool                        canStoneBeRemoved               (fieldPos pos) const;
-
-    // helper functions
-    void			            updateWarning					(fieldPos firstStone, fieldPos secondStone, playerId actingPlayer);
-    void			            updatePossibleMoves				(fieldPos stone, playerStruct& stoneOwner, bool stoneRemoved, fieldPos ignoreStone);
-    void			            updateStonePartOfMill			(fieldPos stoneOne, fieldPos stoneTwo, fieldPos stoneThree, playerId actingPlayer);
 };
 
 // functions related to get the predecessor states
-class fieldStruct_reverse : virtual public fieldStruct_variables
+template <class boardTopology>
+class fieldStructOf_reverse : public fieldStructOf_forward<boardTopology>
 {
+    // the base class depends on the topology, so that its names must be made known explicitly
+    using forward               = fieldStructOf_forward<boardTopology>;
+
 public:
-    void                        getPredecessors                 (std::vector<fieldStruct_types::core>& predFields) const;
+    using typename forward::rules;
+    using typename forward::fieldPos;
+    using typename forward::core;
+    using typename forward::packedCore;
+    using forward::numStonesPerPlayer;
+    using forward::squareMask;
+    using forward::popSquare;
+    using forward::movesAlongLines;
+    using forward::predecessorValidation;
+
+    void                        getPredecessors                 (std::vector<core>& predFields) const;
+    void                        getPredecessors                 (std::vector<packedCore>& predFields) const;
+
+protected:
+    using forward::adjacentSquares;
+    using forward::hashDirty;
+    using forward::allDirty;
+    using forward::updateDeduced;
 
 private:
 
     // get predecessors
-    void                        getPredecessors_normalMove      (std::vector<fieldStruct_types::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const;
-    void                        getPredecessors_jumpingPhase    (std::vector<fieldStruct_types::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const;
-    void                        getPredecessors_settingPhase    (std::vector<fieldStruct_types::core>& predFields, fieldStruct_reverse& field, bool millWasClosed) const;
-    void                        getPredecessors_stoneRemove     (std::vector<fieldStruct_types::core>& predFields, fieldStruct_reverse& field) const;
+    void                        getPredecessors_normalMove      (std::vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const;
+    void                        getPredecessors_jumpingPhase    (std::vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const;
+    void                        getPredecessors_settingPhase    (std::vector<packedCore>& predFields, fieldStructOf_reverse& field, bool millWasClosed) const;
+    void                        getPredecessors_stoneRemove     (std::vector<packedCore>& predFields, fieldStructOf_reverse& field) const;
 
-    bool                        storePredecessor                (std::vector<fieldStruct_types::core>& predFields, const fieldStruct_reverse &field) const;
-    bool                        anyLonelyStone                  (const fieldStruct_reverse &field, fieldPos removedFrom) const;
+    bool                        storePredecessor                (std::vector<packedCore>& predFields, const fieldStructOf_reverse &field) const;
+    bool                        anyLonelyStone                  (const fieldStructOf_reverse &field, fieldPos removedFrom) const;
 };
 
 // class representing the field. this master class is supposed to be used by the class consumers.
-class fieldStruct : public fieldStruct_forward, public fieldStruct_reverse
+template <class boardTopology>
+class fieldStructOf : public fieldStructOf_reverse<boardTopology>
 {
 friend class stateAddressing;
 friend class fieldStruct_Test_test_easy_ones_Test;
 friend class StateAddressingTest_totalNumMissingStones_Test;
 
+    // the base class depends on the topology, so that its names must be made known explicitly
+    using reverse               = fieldStructOf_reverse<boardTopology>;
+
 public:
+    using typename reverse::core;
+    using reverse::reset;
 
 	// constructor
-                                fieldStruct						();
-                                fieldStruct                     (const fieldStruct& other);
-                                ~fieldStruct					();
+                                fieldStructOf					();
+                                fieldStructOf                   (const fieldStructOf& other);
+                                ~fieldStructOf					();
 
-    void                        getPredecessors_2               (std::vector<fieldStruct_types::core>& predFields) const;
+    void                        getPredecessors_2               (std::vector<core>& predFields) const;
 
     // operators
-    bool                        operator==                      (const fieldStruct& other) const;  
+    bool                        operator==                      (const fieldStructOf& other) const;  
+
+protected:
+    using reverse::field;
+    using reverse::settingPhase;
+    using reverse::removalPending;
+    using reverse::stonePartOfMill;
+    using reverse::curPlayer;
+    using reverse::oppPlayer;
+    using reverse::gameHasFinished;
+    using reverse::allDirty;
+    using reverse::updateDeduced;
 };
 
+// the member functions are defined in fieldStruct.cpp, which instantiates the classes for each topology of boardTopology.h
+extern template class fieldStructOf_types<sixMensMorris>;
+extern template class fieldStructOf_variables<sixMensMorris>;
+extern template class fieldStructOf_forward<sixMensMorris>;
+extern template class fieldStructOf_reverse<sixMensMorris>;
+extern template class fieldStructOf<sixMensMorris>;
+extern template class fieldStructOf_types<nineMensMorris>;
+extern template class fieldStructOf_variables<nineMensMorris>;
+extern template class fieldStructOf_forward<nineMensMorris>;
+extern template class fieldStructOf_reverse<nineMensMorris>;
+extern template class fieldStructOf<nineMensMorris>;
+extern template class fieldStructOf_types<twelveMensMorris>;
+extern template class fieldStructOf_variables<twelveMensMorris>;
+extern template class fieldStructOf_forward<twelveMensMorris>;
+extern template class fieldStructOf_reverse<twelveMensMorris>;
+extern template class fieldStructOf<twelveMensMorris>;
+
+// the classes for the board of nine men's morris, which is the only one supported by the state addressing, the AIs and the GUI
+using fieldStruct_types         = fieldStructOf_types<nineMensMorris>;
+using fieldStruct_variables     = fieldStructOf_variables<nineMensMorris>;
+using fieldStruct_forward       = fieldStructOf_forward<nineMensMorris>;
+using fieldStruct_reverse       = fieldStructOf_reverse<nineMensMorris>;
+using fieldStruct               = fieldStructOf<nineMensMorris>;
+
 #endif
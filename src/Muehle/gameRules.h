@@ -0,0 +1,42 @@
+/*********************************************************************\
+	gameRules.h
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+\*********************************************************************/
+
+#ifndef GAME_RULES_H
+#define GAME_RULES_H
+
+/*** Rule sets *******************************************************/
+
+// A rule set fixes the variable rules of the game at compile time, so that the move generation does not check them at runtime:
+//  - jumpingAllowed:               a player with only 'numStonesForJumping' stones left may move a stone to any free square
+//  - numStonesForJumping:          number of stones, at which a player starts to jump
+//  - closeTwoMillsAtOnce:          during the setting phase a stone may be set, although it closes two mills at once
+//  - removeFromTwoMills:           a stone being part of two mills may be removed
+//  - removeFromMillIfOnlyMills:    a stone being part of a mill may be removed, if the opponent has no stones outside of mills
+
+// the rules, for which the database is calculated
+struct standardRules
+{
+    static constexpr bool           jumpingAllowed                  = true;
+    static constexpr unsigned int   numStonesForJumping             = 3;
+    static constexpr bool           closeTwoMillsAtOnce             = false;
+    static constexpr bool           removeFromTwoMills              = false;
+    static constexpr bool           removeFromMillIfOnlyMills       = true;
+};
+
+// the standard rules without jumping
+struct noJumpingRules : public standardRules
+{
+    static constexpr bool           jumpingAllowed                  = false;
+};
+
+// the rule set used by fieldStruct. another one is selected by the compile definition MUEHLE_RULES, e.g. MUEHLE_RULES=noJumpingRules,
+// so that a separate build calculates the database of that rule set.
+#ifndef MUEHLE_RULES
+    #define MUEHLE_RULES standardRules
+#endif
+
+#endif
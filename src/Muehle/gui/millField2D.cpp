@@ -589,7 +589,7 @@ void millField2D::updateStateNumber()
 {
 	wstringstream wss;
 	unsigned int layerNumber;
-	unsigned int stateNumber;
+	stateAddressing::stateId stateNumber;
 
 	playerPerfect->getLayerAndStateNumber(layerNumber, stateNumber);
 	wss << L"layerNumber: " << layerNumber << L"\tstateNumber: " << stateNumber;
@@ -0,0 +1,195 @@
+/**************************************************************************************************************************
+	MuehlePerft.cpp
+ 	Copyright (c) Thomas Weber. All rights reserved.				
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+***************************************************************************************************************************/
+#include "MuehlePerft.h"
+
+// Constants to keep the positions readable
+static const auto x = playerId::playerOne;
+static const auto o = playerId::playerTwo;
+static const auto _ = playerId::squareIsFree;
+
+const std::vector<muehlePerft::testPosition> muehlePerft::testPositions = {
+	{"empty field", {	_,    _,    _,
+						  _,  _,  _,
+						    _,_,_,
+					    _,_,_,  _,_,_,
+						    _,_,_,
+						  _,  _,  _,
+					    _,    _,    _}, x, true, 0, {24, 552, 12144, 255024, 5140800}, 6, 99274176},
+	{"setting phase with mills", {
+						x,    x,    _,
+						  o,  _,  _,
+						    _,o,_,
+					    _,_,_,  _,_,o,
+						    _,_,_,
+						  o,  x,  _,
+					    _,    _,    x}, x, true, 0, {19, 347, 6196, 103909, 1751968}, 6, 27287569},
+	{"midgame", {		x,    x,    o,
+						  o,  x,  _,
+						    x,_,_,
+					    o,_,_,  o,o,_,
+						    _,o,x,
+						  _,  o,  x,
+					    o,    _,    _}, x, false, 0, {11, 157, 721, 10575, 86134, 1164033}, 7, 7671811},
+	{"jumping", {		x,    _,    o,
+						  o,  _,  _,
+						    _,_,o,
+					    _,x,_,  _,o,_,
+						    _,_,_,
+						  o,  _,  x,
+					    _,    o,    _}, x, false, 0, {45, 549, 25240, 312749, 13329032}, 6, 165044719},
+};
+
+//-----------------------------------------------------------------------------
+// Name: main()
+// Desc: Usage: MuehlePerft [maxDepth]
+//       Without arguments the regression values are checked and the benchmark is run afterwards.
+//       With maxDepth only the depths up to maxDepth are calculated. Zero means all depths with a known node count.
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv) 
+{
+    // locals
+    muehlePerft 	perft{};
+
+	if (argc > 1) {
+		return perft.run(std::stoul(argv[1])) ? 0 : 1;
+	}
+	bool allOk = perft.run(0);
+	allOk &= perft.benchmark();
+	return allOk ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Name: run()
+// Desc: Counts the leaf nodes of each test position for depth 1 up to maxDepth and prints the nodes per second.
+//       If maxDepth is zero, all depths with a known node count are calculated.
+//       Returns false if a node count differs from the known one.
+//-----------------------------------------------------------------------------
+bool muehlePerft::run(unsigned int maxDepth) 
+{
+	// locals
+	fieldStruct		field;
+	bool			allOk		= true;
+
+	for (auto& position : testPositions) {
+
+		// set position
+		field.reset(position.curPlayer);
+		if (!field.setSituation(position.field, position.settingPhase, position.totalNumStonesMissing)) {
+			std::cout << "invalid position: " << position.name << std::endl;
+			return false;
+		}
+		std::cout << position.name << std::endl;
+
+		// count nodes for each depth
+		unsigned int lastDepth = maxDepth ? maxDepth : (unsigned int) position.numNodes.size();
+		for (unsigned int depth = 1; depth <= lastDepth; depth++) {
+			auto			start		= std::chrono::steady_clock::now();
+			std::uint64_t	numNodes	= perft(field, depth);
+			double			seconds		= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			bool			known		= rulesOfKnownValues && depth <= position.numNodes.size();
+			bool			ok			= !known || position.numNodes[depth - 1] == numNodes;
+
+			std::cout << "  depth " << std::setw(2) << depth << ": " << std::setw(12) << numNodes << " nodes, ";
+			std::cout << std::setw(12) << (std::uint64_t) (seconds > 0 ? numNodes / seconds : 0) << " nodes/sec";
+			if (!known)	std::cout << std::endl;
+			else if (ok)	std::cout << ", ok" << std::endl;
+			else			std::cout << ", expected " << position.numNodes[depth - 1] << std::endl;
+			allOk &= ok;
+		}
+	}
+	return allOk;
+}
+
+//-----------------------------------------------------------------------------
+// Name: benchmark()
+// Desc: Counts the leaf nodes of each test position for its benchmark depth repeatedly, until minSeconds have passed.
+//       Prints the nodes per second of each position and of all positions together.
+//       Returns false if a node count differs from the known one.
+//-----------------------------------------------------------------------------
+bool muehlePerft::benchmark(double minSeconds)
+{
+	// locals
+	fieldStruct		field;
+	bool			allOk			= true;
+	std::uint64_t	totalNumNodes	= 0;
+	double			totalSeconds	= 0;
+
+	std::cout << "benchmark" << std::endl;
+
+	for (auto& position : testPositions) {
+
+		// set position
+		field.reset(position.curPlayer);
+		if (!field.setSituation(position.field, position.settingPhase, position.totalNumStonesMissing)) {
+			std::cout << "invalid position: " << position.name << std::endl;
+			return false;
+		}
+
+		// repeat until the minimum time has passed
+		std::uint64_t	numNodes		= 0;
+		unsigned int	numRepetitions	= 0;
+		double			seconds			= 0;
+		auto			start			= std::chrono::steady_clock::now();
+		do {
+			std::uint64_t numNodesOfRepetition = perft(field, position.benchmarkDepth);
+			allOk		&= !rulesOfKnownValues || numNodesOfRepetition == position.benchmarkNumNodes;
+			numNodes	+= numNodesOfRepetition;
+			numRepetitions++;
+			seconds		 = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		} while (seconds < minSeconds);
+		totalNumNodes	+= numNodes;
+		totalSeconds	+= seconds;
+
+		std::cout << "  " << std::left << std::setw(26) << position.name << std::right << " depth " << std::setw(2) << position.benchmarkDepth << ", ";
+		std::cout << std::setw(3) << numRepetitions << " x " << std::setw(10) << numNodes / numRepetitions << " nodes, ";
+		std::cout << std::setw(12) << (std::uint64_t) (numNodes / seconds) << " nodes/sec" << std::endl;
+	}
+
+	std::cout << "  total: " << std::setw(12) << (std::uint64_t) (totalSeconds > 0 ? totalNumNodes / totalSeconds : 0) << " nodes/sec";
+	std::cout << (allOk ? ", ok" : ", node counts differ from the known ones") << std::endl;
+	return allOk;
+}
+
+//-----------------------------------------------------------------------------
+// Name: perft()
+// Desc: Returns the number of leaf nodes of the game tree with the passed depth. 
+//       Positions where the game has finished before reaching the depth are not counted.
+//-----------------------------------------------------------------------------
+std::uint64_t muehlePerft::perft(fieldStruct& field, unsigned int depth) 
+{
+	// locals
+	fieldStruct::possibilityArray	possibilityIds;
+	fieldStruct::backupStruct		oldState;
+	unsigned int					numPossibilities	= field.getPossibilities(possibilityIds);
+	std::uint64_t					numNodes			= 0;
+
+	// the leaves do not need to be visited
+	if (depth == 1) return numPossibilities;
+
+	for (unsigned int i = 0; i < numPossibilities; i++) {
+		field.move(moveInfo::getMoveInfo(possibilityIds[i]), oldState);
+		numNodes += perft(field, depth - 1);
+		field.undo(oldState);
+	}
+	return numNodes;
+}
+
+//-----------------------------------------------------------------------------
+// Name: muehlePerft()
+// Desc: constructor
+//-----------------------------------------------------------------------------
+muehlePerft::muehlePerft() 
+{
+}
+
+//-----------------------------------------------------------------------------
+// Name: ~muehlePerft()
+// Desc: destructor
+//-----------------------------------------------------------------------------
+muehlePerft::~muehlePerft() 
+{
+}
@@ -0,0 +1,46 @@
+/**************************************************************************************************************************
+	MuehlePerft.h
+ 	Copyright (c) Thomas Weber. All rights reserved.				
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+***************************************************************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "../fieldStruct.h"
+
+// Counts the leaf nodes of the game tree up to a certain depth using only fieldStruct_forward.
+// The node counts of some canned positions are known and serve as regression values for the move generation.
+// The nodes per second are measured by benchmark() on deeper trees, which are repeated for a minimum time.
+class muehlePerft {
+private:
+    // a canned position together with the known node counts
+    struct testPosition
+    {
+        std::string                 name;                           // name printed in the report
+        fieldStruct::fieldArray     field;                          // stones on the field
+        playerId                    curPlayer;                      // player to move
+        bool                        settingPhase;                   // true if the position is in the setting phase
+        unsigned int                totalNumStonesMissing;          // only used during the setting phase
+        std::vector<std::uint64_t>  numNodes;                       // expected number of leaf nodes for depth 1, 2, ...
+        unsigned int                benchmarkDepth;                 // depth used by benchmark(), which is deeper than the regression values
+        std::uint64_t               benchmarkNumNodes;              // expected number of leaf nodes for benchmarkDepth
+    };
+
+    static const std::vector<testPosition> testPositions;
+    static constexpr bool           rulesOfKnownValues      = std::is_same_v<fieldStruct::rules, standardRules>;   // the known node counts are only valid for the standard rules
+    static constexpr double         minBenchmarkSeconds     = 1.0;  // each position is repeated until this time has passed, so that the nodes per second are stable
+
+    std::uint64_t   perft                   (fieldStruct& field, unsigned int depth);
+
+public:
+    muehlePerft();							        // constructor
+    ~muehlePerft();							        // destructor
+
+    bool            run                     (unsigned int maxDepth);
+    bool            benchmark               (double minSeconds = minBenchmarkSeconds);
+};
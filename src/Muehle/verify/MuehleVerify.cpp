@@ -0,0 +1,237 @@
+/**************************************************************************************************************************
+	MuehleVerify.cpp
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+***************************************************************************************************************************/
+#include "MuehleVerify.h"
+
+//-----------------------------------------------------------------------------
+// Name: main()
+// Desc: Usage: MuehleVerify firstLayer [lastLayer] [numThreads] [directory]
+//       A number of threads of 0 uses all hardware threads. The directory is used for the cached variables of the state addressing.
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		std::cout << "Usage: MuehleVerify firstLayer [lastLayer] [numThreads] [directory]" << std::endl;
+		return 1;
+	}
+
+	// locals
+	unsigned int	firstLayer	= std::stoul(argv[1]);
+	unsigned int	lastLayer	= (argc > 2) ? std::stoul(argv[2]) : firstLayer;
+	unsigned int	numThreads	= (argc > 3) ? std::stoul(argv[3]) : 0;
+	std::wstring	directory	= (argc > 4) ? std::filesystem::path(argv[4]).wstring() : std::wstring(L".");
+	muehleVerify	verify{directory, 10};
+
+	if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+
+	return verify.run(firstLayer, lastLayer, numThreads) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Name: run()
+// Desc: Checks all states of the layers from firstLayer to lastLayer and prints the statistics and the first mismatches.
+//       Returns false if a mismatch has been found.
+//-----------------------------------------------------------------------------
+bool muehleVerify::run(stateAddressing::layerId firstLayer, stateAddressing::layerId lastLayer, unsigned int numThreads)
+{
+	// locals
+	std::uint64_t	totalNumMismatches	= 0;
+
+	// the number of hardware threads might not be known
+	if (numThreads == 0) numThreads = 1;
+
+	// generate the predecessors with the cheap checks only, so that verifyState() compares them with the full ones
+	fieldStruct::predecessorValidation = validationLevel::cheap;
+
+	if (lastLayer >= stateAddressing::NUM_LAYERS || firstLayer > lastLayer) {
+		std::cout << "invalid layer range" << std::endl;
+		return false;
+	}
+
+	for (stateAddressing::layerId layerNum = firstLayer; layerNum <= lastLayer; layerNum++) {
+
+		// skip layers without states
+		if (!sa.getNumberOfKnotsInLayer(layerNum)) continue;
+
+		layerResultStruct	result;
+		auto				start		= std::chrono::steady_clock::now();
+		verifyLayer(layerNum, numThreads, result);
+		double				seconds		= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "layer " << std::setw(3) << layerNum << ": " << std::setw(10) << sa.getNumberOfKnotsInLayer(layerNum) << " states, ";
+		std::cout << std::setw(10) << result.numStatesChecked << " valid, ";
+		std::cout << std::setw(12) << result.numPredecessors << " predecessors, ";
+		std::cout << std::setw(12) << result.numSuccessors << " successors, ";
+		std::cout << std::setw(6) << result.numMismatches << " mismatches, ";
+		std::cout << std::fixed << std::setprecision(1) << seconds << " sec" << std::endl;
+		totalNumMismatches += result.numMismatches;
+	}
+
+	// print the first mismatches
+	for (auto& mismatch : mismatches) {
+		printMismatch(mismatch);
+	}
+	std::cout << (totalNumMismatches ? "verification failed" : "verification ok") << std::endl;
+	return totalNumMismatches == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Name: verifyLayer()
+// Desc: Checks all states of a layer. The threads take chunks of states from a common counter, since the effort per state varies a lot.
+//       Within a chunk the states are enumerated by a layerIterator. Invalid state numbers, which do not represent a reachable state, are skipped.
+//       The mismatches of a chunk are merged at its end, so that the reported ones do not depend on the order in which the threads finish.
+//-----------------------------------------------------------------------------
+void muehleVerify::verifyLayer(stateAddressing::layerId layerNum, unsigned int numThreads, layerResultStruct& result)
+{
+	// locals
+	const stateAddressing::stateId		numStates		= sa.getNumberOfKnotsInLayer(layerNum);
+	std::atomic<stateAddressing::stateId>	nextState		= 0;
+	std::vector<std::thread>			threads;
+
+	auto worker = [&]() {
+		std::vector<mismatchStruct> chunkMismatches;
+		for (;;) {
+			stateAddressing::stateId first = nextState.fetch_add(statesPerChunk);
+			if (first >= numStates) return;
+			stateAddressing::stateId last = (numStates - first < statesPerChunk) ? numStates : first + statesPerChunk;
+			for (stateAddressing::layerIterator it(sa, layerNum, fieldStruct::playerWhite, first, last); !it.isEnd(); it.next()) {
+				if (it.isValid()) verifyState(layerNum, it.getStateNumber(), it.getField(), result, chunkMismatches);
+			}
+			if (chunkMismatches.size()) mergeMismatches(chunkMismatches);
+		}
+	};
+
+	for (unsigned int threadNo = 0; threadNo < numThreads; threadNo++) {
+		threads.emplace_back(worker);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: verifyState()
+// Desc: Checks that each predecessor has the state among its successors, and that each successor has the state among its predecessors.
+//-----------------------------------------------------------------------------
+void muehleVerify::verifyState(stateAddressing::layerId layerNum, stateAddressing::stateId stateNumber, const fieldStruct& field, layerResultStruct& result, std::vector<mismatchStruct>& chunkMismatches)
+{
+	// locals
+	fieldStruct								other;
+	fieldStruct::successorArray				successors;
+	std::vector<fieldStruct::packedCore>	predFields;
+	std::vector<fieldStruct::packedCore>	otherPredFields;
+	bool									mismatch			= false;
+
+	const fieldStruct::packedCore state{field};
+	result.numStatesChecked++;
+
+	// backward: the state must be a successor of each predecessor. setSituation() applies the full checks.
+	field.getPredecessors(predFields);
+	for (auto& pred : predFields) {
+		if (!other.setSituation(pred)) {
+			reportMismatch(chunkMismatches, layerNum, stateNumber, state, pred, "predecessor passes the cheap checks, but not the full ones");
+			mismatch = true;
+			continue;
+		}
+		unsigned int	numSuccessors	= other.getSuccessors(successors);
+		bool			found			= false;
+		for (unsigned int i = 0; i < numSuccessors && !found; i++) {
+			found = successors[i].state == state;
+		}
+		if (!found) {
+			reportMismatch(chunkMismatches, layerNum, stateNumber, state, pred, "state is not a successor of its predecessor");
+			mismatch = true;
+		}
+	}
+	result.numPredecessors += predFields.size();
+
+	// forward: the state must be a predecessor of each successor
+	unsigned int numSuccessors = field.getSuccessors(successors);
+	for (unsigned int i = 0; i < numSuccessors; i++) {
+		const fieldStruct::packedCore& succ = successors[i].state;
+		if (!other.setSituation(succ)) {
+			reportMismatch(chunkMismatches, layerNum, stateNumber, state, succ, "invalid successor");
+			mismatch = true;
+			continue;
+		}
+		other.getPredecessors(otherPredFields);
+		if (std::find(otherPredFields.begin(), otherPredFields.end(), state) == otherPredFields.end()) {
+			reportMismatch(chunkMismatches, layerNum, stateNumber, state, succ, "state is not a predecessor of its successor");
+			mismatch = true;
+		}
+	}
+	result.numSuccessors += numSuccessors;
+
+	if (mismatch) result.numMismatches++;
+}
+
+//-----------------------------------------------------------------------------
+// Name: reportMismatch()
+// Desc: Stores the mismatch of the current chunk, as long as the maximum number of reported mismatches is not reached within the chunk.
+//       Since the states of a chunk are checked in ascending order, the stored ones are the first mismatches of the chunk.
+//-----------------------------------------------------------------------------
+void muehleVerify::reportMismatch(std::vector<mismatchStruct>& chunkMismatches, stateAddressing::layerId layerNum, stateAddressing::stateId stateNumber, const fieldStruct::packedCore& state, const fieldStruct::packedCore& other, const char* description)
+{
+	if (chunkMismatches.size() < maxNumReportedMismatches) {
+		chunkMismatches.push_back({layerNum, stateNumber, state, other, description});
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Name: mergeMismatches()
+// Desc: Merges the mismatches of a chunk into the reported ones, which are kept ordered by layer and state number.
+//       Only the first maxNumReportedMismatches are kept. The vector chunkMismatches is cleared afterwards.
+//-----------------------------------------------------------------------------
+void muehleVerify::mergeMismatches(std::vector<mismatchStruct>& chunkMismatches)
+{
+	auto isBefore = [](const mismatchStruct& a, const mismatchStruct& b) {
+		return a.layerNum < b.layerNum || (a.layerNum == b.layerNum && a.stateNumber < b.stateNumber);
+	};
+
+	std::lock_guard<std::mutex> lock(mismatchesMutex);
+	size_t numMerged = mismatches.size();
+	mismatches.insert(mismatches.end(), chunkMismatches.begin(), chunkMismatches.end());
+	std::inplace_merge(mismatches.begin(), mismatches.begin() + numMerged, mismatches.end(), isBefore);
+	if (mismatches.size() > maxNumReportedMismatches) {
+		mismatches.erase(mismatches.begin() + maxNumReportedMismatches, mismatches.end());
+	}
+	chunkMismatches.clear();
+}
+
+//-----------------------------------------------------------------------------
+// Name: printMismatch()
+// Desc: Prints the checked state and the predecessor or successor causing the mismatch.
+//-----------------------------------------------------------------------------
+void muehleVerify::printMismatch(const mismatchStruct& mismatch) const
+{
+	// locals
+	fieldStruct field;
+
+	std::cout << std::endl << "layer " << mismatch.layerNum << ", state " << mismatch.stateNumber << ": " << mismatch.description << std::endl;
+	std::cout << "state:" << std::endl;
+	if (field.setSituation(mismatch.state))	field.print();
+	std::cout << std::endl << "predecessor or successor:" << std::endl;
+	if (field.setSituation(mismatch.other))	field.print();
+	else									std::cout << "invalid state" << std::endl;
+	std::cout << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+// Name: muehleVerify()
+// Desc: constructor
+//-----------------------------------------------------------------------------
+muehleVerify::muehleVerify(std::wstring const& directory, unsigned int maxNumReportedMismatches)
+	: sa{directory}, maxNumReportedMismatches{maxNumReportedMismatches}
+{
+}
+
+//-----------------------------------------------------------------------------
+// Name: ~muehleVerify()
+// Desc: destructor
+//-----------------------------------------------------------------------------
+muehleVerify::~muehleVerify()
+{
+}
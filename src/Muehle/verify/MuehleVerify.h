@@ -0,0 +1,63 @@
+/**************************************************************************************************************************
+	MuehleVerify.h
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+***************************************************************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+#include "../fieldStruct.h"
+#include "../ai/stateAddressing.h"
+
+// Checks for all states of some layers, that the forward and the backward move generation are exact inverses:
+// Each predecessor of a state must have the state among its successors, and each successor must have the state among its predecessors.
+// The retro analysis of the database relies on this, so that a change of the rules can be validated before the database is calculated.
+// The predecessors are generated with the cheap checks only. Each of them must pass the full checks as well, so that both levels yield the same predecessors.
+class muehleVerify {
+private:
+	// a state, for which the forward and backward move generation do not match
+	struct mismatchStruct
+	{
+		stateAddressing::layerId		layerNum;						// layer of the checked state
+		stateAddressing::stateId		stateNumber;					// state number of the checked state
+		fieldStruct::packedCore			state;							// the checked state
+		fieldStruct::packedCore			other;							// the predecessor or successor causing the mismatch
+		std::string						description;					// kind of mismatch
+	};
+
+	// statistics of a layer
+	struct layerResultStruct
+	{
+		std::atomic<std::uint64_t>		numStatesChecked				= 0;	// number of valid states, which have been checked
+		std::atomic<std::uint64_t>		numPredecessors					= 0;	// number of checked predecessors
+		std::atomic<std::uint64_t>		numSuccessors					= 0;	// number of checked successors
+		std::atomic<std::uint64_t>		numMismatches					= 0;	// number of states with a mismatch
+	};
+
+	static const unsigned int			statesPerChunk					= 256;	// number of states, which a thread takes at once from the layer
+
+	stateAddressing						sa;								// state addressing used to enumerate the states of a layer
+	unsigned int						maxNumReportedMismatches;		// number of mismatches, which are printed
+	std::vector<mismatchStruct>			mismatches;						// the first mismatches found, ordered by layer and state number
+	std::mutex							mismatchesMutex;				// protects 'mismatches'
+
+	void			verifyLayer				(stateAddressing::layerId layerNum, unsigned int numThreads, layerResultStruct& result);
+	void			verifyState				(stateAddressing::layerId layerNum, stateAddressing::stateId stateNumber, const fieldStruct& field, layerResultStruct& result, std::vector<mismatchStruct>& chunkMismatches);
+	void			reportMismatch			(std::vector<mismatchStruct>& chunkMismatches, stateAddressing::layerId layerNum, stateAddressing::stateId stateNumber, const fieldStruct::packedCore& state, const fieldStruct::packedCore& other, const char* description);
+	void			mergeMismatches			(std::vector<mismatchStruct>& chunkMismatches);
+	void			printMismatch			(const mismatchStruct& mismatch) const;
+
+public:
+	muehleVerify(std::wstring const& directory, unsigned int maxNumReportedMismatches);		// constructor
+	~muehleVerify();																			// destructor
+
+	bool			run						(stateAddressing::layerId firstLayer, stateAddressing::layerId lastLayer, unsigned int numThreads);
+};
@@ -0,0 +1,146 @@
+/**************************************************************************************************************************
+	fieldBatchTest.cpp
+ 	Copyright (c) Thomas Weber. All rights reserved.
+	Licensed under the MIT License.
+	https://github.com/madweasel/madweasels-cpp
+***************************************************************************************************************************/
+#include "gtest/gtest.h"
+#include "fieldBatch.h"
+
+// Constants to simplify the test
+const auto x = playerId::playerOne;
+const auto o = playerId::playerTwo;
+const auto _ = playerId::squareIsFree;
+using FIELD  = fieldStruct::fieldArray;
+
+// Helper function returning the states of random games and their predecessors, so that all phases and game ends are contained
+std::vector<fieldStruct::packedCore> getRandomStates(unsigned int numGames)
+{
+	// locals
+	fieldStruct 							fs;
+	fieldStruct::backupStruct 				oldState;
+	std::vector<unsigned int> 				possibilityIds;
+	std::vector<fieldStruct::packedCore> 	predFields;
+	std::vector<fieldStruct::packedCore> 	states;
+
+	srand(1);
+	for (unsigned int game = 0; game < numGames; game++) {
+		fs.reset(game % 2 ? o : x);
+		for (unsigned int step = 0; step < 100; step++) {
+			states.push_back(fieldStruct::packedCore{fs});
+			fs.getPredecessors(predFields);
+			states.insert(states.end(), predFields.begin(), predFields.end());
+			fs.getPossibilities(possibilityIds);
+			if (possibilityIds.empty()) break;
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[rand() % possibilityIds.size()]), oldState));
+		}
+	}
+	return states;
+}
+
+// Helper function to compare a lane of the batch with a fieldStruct being in the same state
+void checkLane(const fieldBatch& batch, unsigned int lane, const fieldStruct::packedCore& state)
+{
+	// locals
+	fieldStruct fs;
+	ASSERT_TRUE(fs.setSituation(state));
+
+	for (unsigned int pos = 0; pos < fieldStruct::size; pos++) {
+		EXPECT_EQ(batch.getStonePartOfMill(lane, pos), fs.isStonePartOfMill(pos));
+	}
+	EXPECT_EQ(batch.curPlayerNumberOfMills[lane], 		fs.getCurPlayer().numberOfMills);
+	EXPECT_EQ(batch.oppPlayerNumberOfMills[lane], 		fs.getOppPlayer().numberOfMills);
+	EXPECT_EQ(batch.curPlayerNumPossibleMoves[lane], 	fs.getCurPlayer().numPossibleMoves);
+	EXPECT_EQ(batch.oppPlayerNumPossibleMoves[lane], 	fs.getOppPlayer().numPossibleMoves);
+	EXPECT_EQ(batch.removableStones[lane], 				fs.getPossStoneRemove());
+
+	playerId winner = fs.getWinner();
+	if 		(winner == fs.getCurPlayer().id)	EXPECT_EQ(batch.winner[lane], fieldBatch::curPlayerWon);
+	else if (winner == fs.getOppPlayer().id)	EXPECT_EQ(batch.winner[lane], fieldBatch::oppPlayerWon);
+	else										EXPECT_EQ(batch.winner[lane], fieldBatch::gameNotFinished);
+	EXPECT_EQ(batch.winner[lane] != fieldBatch::gameNotFinished, fs.hasGameFinished());
+}
+
+TEST(fieldBatch_Test, test_randomStates)
+{
+	// locals
+	std::vector<fieldStruct::packedCore> 	states = getRandomStates(20);
+	fieldBatch 								batch, reference;
+
+	ASSERT_GT(states.size(), 1000);
+
+	for (size_t first = 0; first < states.size(); first += fieldBatch::numLanes) {
+		batch.clear();
+		for (unsigned int lane = 0; lane < fieldBatch::numLanes && first + lane < states.size(); lane++) {
+			batch.set(lane, states[first + lane]);
+		}
+		reference = batch;
+		batch.calculate();
+		reference.calculateScalar();
+
+		// the SIMD implementation must match the scalar one bit for bit
+		EXPECT_EQ(batch.stonesInMill, 				reference.stonesInMill);
+		EXPECT_EQ(batch.stonesInTwoMills, 			reference.stonesInTwoMills);
+		EXPECT_EQ(batch.curPlayerNumberOfMills, 	reference.curPlayerNumberOfMills);
+		EXPECT_EQ(batch.oppPlayerNumberOfMills, 	reference.oppPlayerNumberOfMills);
+		EXPECT_EQ(batch.curPlayerNumPossibleMoves, 	reference.curPlayerNumPossibleMoves);
+		EXPECT_EQ(batch.oppPlayerNumPossibleMoves, 	reference.oppPlayerNumPossibleMoves);
+		EXPECT_EQ(batch.removableStones, 			reference.removableStones);
+		EXPECT_EQ(batch.winner, 					reference.winner);
+
+		// and both must match the fieldStruct
+		for (unsigned int lane = 0; lane < fieldBatch::numLanes && first + lane < states.size(); lane++) {
+			checkLane(batch, lane, states[first + lane]);
+		}
+	}
+}
+
+TEST(fieldBatch_Test, test_gameFinished)
+{
+	// locals
+	fieldStruct 	fs;
+	fieldBatch 		batch;
+
+	batch.clear();
+
+	// current player is immobilized
+	FIELD blocked = {	x,    o,    x,
+						  _,  _,  _,
+						    _,_,_,
+					    o,_,_,  _,_,o,
+						    _,_,_,
+						  _,  _,  _,
+					    x,    o,    x};
+	fs.reset(x);
+	ASSERT_TRUE(fs.setSituation(blocked, false, 0));
+	batch.set(0, fieldStruct::packedCore{fs});
+
+	// current player has only two stones left, after the opponent closed a mill
+	FIELD twoStones = {	x,    _,    _,
+						  o,  o,  o,
+						    _,_,_,
+					    x,_,_,  _,_,o,
+						    _,_,_,
+						  _,  _,  _,
+					    _,    _,    _};
+	fs.reset(x);
+	ASSERT_TRUE(fs.setSituation(twoStones, false, 0));
+	batch.set(1, fieldStruct::packedCore{fs});
+
+	batch.calculate();
+	EXPECT_EQ(batch.winner[0], fieldBatch::oppPlayerWon);
+	EXPECT_EQ(batch.winner[1], fieldBatch::oppPlayerWon);
+	EXPECT_EQ(batch.winner[2], fieldBatch::gameNotFinished);
+	EXPECT_EQ(batch.curPlayerNumPossibleMoves[0], 0);
+	EXPECT_EQ(batch.curPlayerNumPossibleMoves[2], static_cast<unsigned int>(fieldStruct::size));
+}
+
+TEST(fieldBatch_Test, test_simdEnabled)
+{
+	// the target fieldBatchTest_avx2 defines MUEHLE_EXPECT_SIMD, so that it fails if calculate() falls back to the scalar implementation
+#if defined(MUEHLE_EXPECT_SIMD)
+	EXPECT_TRUE(fieldBatch::simdEnabled);
+#else
+	GTEST_SKIP() << "the SIMD implementation is only expected by fieldBatchTest_avx2";
+#endif
+}
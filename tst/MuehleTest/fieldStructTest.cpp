@@ -277,7 +277,7 @@ TEST(fieldStruct_Test, test_move_numPossibleMoves)
 								    _,_,x,  x,x,x,
 									    _,_,_,
 									  _,  _,  _,
-								    _,    _,    _}, false, 0, moveInfo{11, 15, fieldStruct::size}, 3*17, 8, 3*17);
+								    _,    _,    _}, false, 0, moveInfo{11, 15, fieldStruct::size}, fieldStruct::rules::jumpingAllowed ? 3*17 : 5, 8, fieldStruct::rules::jumpingAllowed ? 3*17 : 5);
 
 	// jumping phase, closing a mill
 	check_move_numPossibleMoves({	_,    o,    _,
@@ -576,6 +576,8 @@ TEST(fieldStruct_Test, test_StoneRemovalWhenThereAreOnlyMills_movingPhase_single
 
 TEST(fieldStruct_Test, test_StoneRemovalWhenThereAreOnlyMills_jumpingPhase)
 {
+	if (!fieldStruct::rules::jumpingAllowed) GTEST_SKIP() << "Skipping test: The rule set does not allow jumping.";
+
 	// jumping phase with 1 mill for the current player 'x', 1 mill for the opponent 'o'. all stones of the opponent are part of a mill.
 	fieldStruct 					fs;
 	fieldStruct::backupStruct 		oldState;
@@ -643,3 +645,613 @@ TEST(fieldStruct_Test, test_StoneRemovalWhenThereAreOnlyMills_jumpingPhase)
 	}
 	EXPECT_TRUE(found);
 }
+
+// Helper function to check if the bit masks of both players match the field array
+void checkStoneMasks(const fieldStruct& fs)
+{
+	bitBoard curStones = 0, oppStones = 0;
+	for (fieldStruct::fieldPos pos = 0; pos < fieldStruct::size; pos++) {
+		if (fs.getStone(pos) == fs.getCurPlayer().id) curStones |= fieldStruct::squareMask(pos);
+		if (fs.getStone(pos) == fs.getOppPlayer().id) oppStones |= fieldStruct::squareMask(pos);
+	}
+	EXPECT_EQ(fs.getCurPlayer().stones, curStones);
+	EXPECT_EQ(fs.getOppPlayer().stones, oppStones);
+	EXPECT_EQ(fs.getFreeSquares(), fieldStruct::allSquares & ~(curStones | oppStones));
+}
+
+TEST(fieldStruct_Test, test_bitBoard_consistency)
+{
+	// locals
+	fieldStruct 					fs;
+	fieldStruct::backupStruct 		oldState;
+	std::vector<unsigned int> 		possibilityIds;
+	std::vector<fieldStruct::core> 	predFields;
+	FIELD field = {	x,    x,    o,
+					  o,  x,  x,
+					    x,_,_,
+				    o,_,_,  o,o,_,
+					    _,o,x,
+					  _,  o,  x,
+				    o,    o,    _};
+
+	// the masks must follow setSituation(), invert() and each move and undo
+	EXPECT_TRUE(setState(fs, field, x, false, 0));
+	checkStoneMasks(fs);
+	fs.invert();
+	checkStoneMasks(fs);
+	fs.invert();
+	checkStoneMasks(fs);
+
+	fs.getPossibilities(possibilityIds);
+	for (auto id : possibilityIds) {
+		fieldStruct fsBefore = fs;
+		EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(id), oldState));
+		checkStoneMasks(fs);
+		EXPECT_TRUE(fs.undo(oldState));
+		EXPECT_EQ(fs, fsBefore);
+	}
+
+	// predecessors must not modify the field
+	fieldStruct fsBefore = fs;
+	fs.getPredecessors(predFields);
+	EXPECT_EQ(fs, fsBefore);
+	checkStoneMasks(fs);
+}
+
+TEST(fieldStruct_Test, test_hashKey)
+{
+	// locals
+	fieldStruct 					fs, fsSet;
+	fieldStruct::backupStruct 		oldState;
+	std::vector<unsigned int> 		possibilityIds;
+	FIELD field = {	x,    _,    o,
+					  o,  x,  _,
+					    _,_,_,
+				    o,_,_,  o,x,_,
+					    _,o,x,
+					  _,  _,  _,
+				    _,    _,    _};
+
+	// the incremental key after each move must be equal to the one calculated from scratch by setSituation()
+	EXPECT_TRUE(setState(fs, field, x, true, 0));
+	for (unsigned int step = 0; step < 30 && !fs.hasGameFinished(); step++) {
+		fs.getPossibilities(possibilityIds);
+		ASSERT_FALSE(possibilityIds.empty());
+		hashKey keyBefore = fs.getHashKey();
+		for (auto id : possibilityIds) {
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(id), oldState));
+			EXPECT_NE(fs.getHashKey(), keyBefore);
+			unsigned int totalNumStonesMissing = fs.inSettingPhase() ? fs.getCurPlayer().numStonesMissing + fs.getOppPlayer().numStonesMissing : 0;
+			if (!fs.hasGameFinished() && setState(fsSet, fs.getField(), fs.getCurPlayer().id, fs.inSettingPhase(), totalNumStonesMissing)) {
+				EXPECT_EQ(fs.getHashKey(), fsSet.getHashKey());
+			}
+			EXPECT_TRUE(fs.undo(oldState));
+			EXPECT_EQ(fs.getHashKey(), keyBefore);
+		}
+		EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[step % possibilityIds.size()]), oldState));
+	}
+
+	// the player to move is part of the key
+	field[16] = _;
+	EXPECT_TRUE(setState(fs,    field, x, true, 0));
+	EXPECT_TRUE(setState(fsSet, field, o, true, 0));
+	EXPECT_NE(fs.getHashKey(), fsSet.getHashKey());
+
+	// invert twice restores the key
+	hashKey keyBefore = fs.getHashKey();
+	fs.invert();
+	EXPECT_NE(fs.getHashKey(), keyBefore);
+	fs.invert();
+	EXPECT_EQ(fs.getHashKey(), keyBefore);
+}
+
+TEST(fieldStruct_Test, test_getPossibilities_buffer)
+{
+	// locals
+	fieldStruct 					fs;
+	fieldStruct::possibilityArray	buffer;
+	std::vector<unsigned int> 		possibilityIds;
+
+	// the buffer variant must deliver the same possibilities in the same order as the vector variant
+	for (bool settingPhase : {true, false}) {
+		EXPECT_TRUE(setState(fs, {	x,    x,    o,
+									  o,  x,  x,
+									    x,_,_,
+								    o,_,_,  o,o,_,
+									    _,o,x,
+									  _,  o,  x,
+								    o,    o,    _}, x, settingPhase, settingPhase ? 1 : 0));
+		fs.getPossibilities(possibilityIds);
+		unsigned int numPossibilities = fs.getPossibilities(buffer);
+		EXPECT_GT(numPossibilities, 0);
+		EXPECT_EQ(std::vector<unsigned int>(buffer.begin(), buffer.begin() + numPossibilities), possibilityIds);
+	}
+}
+
+TEST(fieldStruct_Test, test_undo_compactBackup)
+{
+	// locals
+	fieldStruct 					fs;
+	fieldStruct::backupStruct 		oldState;
+	FIELD field = {	o,    o,    _,
+					  _,  _,  _,
+					    _,_,x,
+				    _,_,_,  x,_,_,
+					    x,_,_,
+					  _,  _,  _,
+				    o,    _,    _};
+
+	// the backup only contains the delta, not the whole field
+	EXPECT_LE(sizeof(fieldStruct::backupStruct), 32);
+
+	// a refused move must not be reverted by undo()
+	EXPECT_TRUE(setState(fs, field, x, false, 0));
+	fieldStruct fsBefore = fs;
+	EXPECT_FALSE(fs.move(moveInfo{0, 2, fieldStruct::size}, oldState));
+	EXPECT_TRUE(fs.undo(oldState));
+	EXPECT_EQ(fs, fsBefore);
+
+	// closing a mill and removing a stone, which finishes the game, is reverted completely
+	EXPECT_TRUE(fs.move(moveInfo{15, 17, 1}, oldState));
+	EXPECT_TRUE(fs.hasGameFinished());
+	EXPECT_TRUE(fs.undo(oldState));
+	EXPECT_EQ(fs, fsBefore);
+	EXPECT_EQ(fs.getHashKey(), fsBefore.getHashKey());
+	EXPECT_EQ(fs.getCurPlayer().numberOfMills, 0);
+	EXPECT_EQ(fs.getOppPlayer().numberOfMills, 0);
+	for (fieldStruct::fieldPos pos = 0; pos < fieldStruct::size; pos++) {
+		EXPECT_EQ(fs.isStonePartOfMill(pos), fsBefore.isStonePartOfMill(pos));
+	}
+}
+
+TEST(fieldStruct_Test, test_packedMove)
+{
+	// the packed id must be identical to the possibility id for every combination of squares
+	EXPECT_LE(sizeof(packedMove), 2);
+	for (unsigned int from = 0; from <= fieldStruct::size; from++) {
+		for (unsigned int to = 0; to <= fieldStruct::size; to++) {
+			for (unsigned int removeStone = 0; removeStone <= fieldStruct::size; removeStone++) {
+				moveInfo 	move{from, to, removeStone};
+				packedMove 	packed{from, to, removeStone};
+				EXPECT_EQ(packed.id, move.getId());
+				EXPECT_EQ(packed.from(), from);
+				EXPECT_EQ(packed.to(), to);
+				EXPECT_EQ(packed.removeStone(), removeStone);
+				EXPECT_EQ(moveInfo::getMoveInfo(move.getId()), move);
+			}
+		}
+	}
+
+	// ids are compatible with the former encoding
+	EXPECT_EQ((moveInfo{fieldStruct::size, 14, 3}.getId()), (fieldStruct::size * 25 + 14) * 25 + 3);
+
+	// invalid ids lead to the default move without throwing an exception
+	EXPECT_FALSE(packedMove{packedMove::numIds}.isValid());
+	EXPECT_NO_THROW(moveInfo::getMoveInfo(packedMove::numIds));
+	EXPECT_EQ(moveInfo::getMoveInfo(packedMove::numIds), moveInfo{});
+	EXPECT_EQ(moveInfo::getMoveInfo(1u << 20), moveInfo{});
+}
+
+TEST(fieldStruct_Test, test_getSuccessors)
+{
+	// locals
+	fieldStruct 						fs;
+	fieldStruct::backupStruct 			oldState;
+	fieldStruct::successorArray			successors;
+	std::vector<unsigned int> 			possibilityIds;
+	FIELD field = {	x,    x,    o,
+					  o,  x,  x,
+					    x,_,_,
+				    o,_,_,  o,o,_,
+					    _,o,x,
+					  _,  o,  x,
+				    o,    o,    _};
+
+	// each successor must be equal to the state reached by move()
+	auto checkSuccessors = [&]() {
+		fieldStruct::backupStruct oldState;
+		fs.getPossibilities(possibilityIds);
+		unsigned int numSuccessors = fs.getSuccessors(successors);
+		ASSERT_EQ(numSuccessors, possibilityIds.size());
+		for (unsigned int i = 0; i < numSuccessors; i++) {
+			EXPECT_EQ(successors[i].possibilityId, possibilityIds[i]);
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[i]), oldState));
+			const fieldStruct::packedCore expected{fs};
+			EXPECT_EQ(successors[i].state.getCurPlayerStones(), 			expected.getCurPlayerStones());
+			EXPECT_EQ(successors[i].state.getOppPlayerStones(), 			expected.getOppPlayerStones());
+			EXPECT_EQ(successors[i].state.getCurPlayerId(), 				expected.getCurPlayerId());
+			EXPECT_EQ(successors[i].state.getCurPlayerNumStonesMissing(), 	expected.getCurPlayerNumStonesMissing());
+			EXPECT_EQ(successors[i].state.getOppPlayerNumStonesMissing(), 	expected.getOppPlayerNumStonesMissing());
+			EXPECT_EQ(successors[i].state.inSettingPhase(), 				expected.inSettingPhase());
+			EXPECT_TRUE(successors[i].state == expected);
+			EXPECT_TRUE(fs.undo(oldState));
+		}
+	};
+
+	for (auto [settingPhase, curPlayer] : {std::pair{true, x}, std::pair{false, x}, std::pair{false, o}}) {
+		EXPECT_TRUE(setState(fs, field, curPlayer, settingPhase, settingPhase ? 1 : 0));
+		checkSuccessors();
+
+		// with a pending stone removal the successors are the states after the removal
+		unsigned int numRemovalsPending = 0;
+		fs.setStoneRemoval(stoneRemoval::separatePly);
+		fs.getPossibilities(possibilityIds);
+		for (auto id : std::vector<unsigned int>{possibilityIds}) {
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(id), oldState));
+			if (fs.isRemovalPending()) {
+				numRemovalsPending++;
+				checkSuccessors();
+			}
+			EXPECT_TRUE(fs.undo(oldState));
+		}
+		EXPECT_GT(numRemovalsPending, 0);
+		fs.setStoneRemoval(stoneRemoval::withinMove);
+	}
+}
+
+TEST(fieldStruct_Test, test_packedCore)
+{
+	// locals
+	fieldStruct 						fs;
+	fieldStruct 						fsTmp;
+	fieldStruct::backupStruct 			oldState;
+	std::vector<unsigned int> 			possibilityIds;
+	std::vector<fieldStruct::core> 		predFields;
+	std::vector<fieldStruct::packedCore> packedPredFields;
+
+	EXPECT_EQ(sizeof(fieldStruct::packedCore), 8);
+
+	// play random games and check that the packed core represents the same state
+	srand(1);
+	for (unsigned int game = 0; game < 20; game++) {
+		fs.reset(game % 2 ? o : x);
+		for (unsigned int step = 0; step < 60; step++) {
+			fieldStruct::core		state{fs};
+			fieldStruct::packedCore	packed{fs};
+			fieldStruct::core		unpacked = packed.unpack();
+			EXPECT_EQ(packed, 								fieldStruct::packedCore{state});
+			EXPECT_EQ(unpacked.field, 						state.field);
+			EXPECT_EQ(unpacked.settingPhase, 				state.settingPhase);
+			EXPECT_EQ(unpacked.curPlayer.id, 				state.curPlayer.id);
+			EXPECT_EQ(unpacked.curPlayer.numStones, 		state.curPlayer.numStones);
+			EXPECT_EQ(unpacked.curPlayer.numStonesMissing, 	state.curPlayer.numStonesMissing);
+			EXPECT_EQ(unpacked.oppPlayer.id, 				state.oppPlayer.id);
+			EXPECT_EQ(unpacked.oppPlayer.numStones, 		state.oppPlayer.numStones);
+			EXPECT_EQ(unpacked.oppPlayer.numStonesMissing, 	state.oppPlayer.numStonesMissing);
+
+			// set the packed state on another field
+			EXPECT_TRUE(fsTmp.setSituation(packed));
+			EXPECT_EQ(fsTmp.getField(), 		fs.getField());
+			EXPECT_EQ(fsTmp.getCurPlayer().id, 	fs.getCurPlayer().id);
+			EXPECT_EQ(fsTmp.inSettingPhase(), 	fs.inSettingPhase());
+
+			// both kinds of predecessors must be identical
+			fs.getPredecessors(predFields);
+			fs.getPredecessors(packedPredFields);
+			ASSERT_EQ(predFields.size(), packedPredFields.size());
+			for (size_t i = 0; i < predFields.size(); i++) {
+				EXPECT_EQ(packedPredFields[i], fieldStruct::packedCore{predFields[i]});
+			}
+
+			fs.getPossibilities(possibilityIds);
+			if (possibilityIds.empty()) break;
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[rand() % possibilityIds.size()]), oldState));
+		}
+	}
+}
+
+// Helper function to check the tables of a topology
+template <class topology>
+void checkTopology(unsigned int numMillsExpected)
+{
+	using tables = topologyTables<topology>;
+
+	EXPECT_EQ(tables::numMills, numMillsExpected);
+
+	for (unsigned int pos = 0; pos < tables::size; pos++) {
+
+		// connections go in both directions and not to the square itself
+		EXPECT_FALSE(tables::adjacentSquares[pos] & (bitBoard{1} << pos));
+		for (unsigned int other = 0; other < tables::size; other++) {
+			EXPECT_EQ(bool(tables::adjacentSquares[pos] & (bitBoard{1} << other)), bool(tables::adjacentSquares[other] & (bitBoard{1} << pos)));
+		}
+
+		// each square is part of at least one mill, and each listed mill contains the square
+		unsigned int numMillsOfSquare = 0;
+		for (bitBoard mill : tables::millsOfSquare[pos]) {
+			if (mill == tables::unusedMill) continue;
+			EXPECT_TRUE(mill & (bitBoard{1} << pos));
+			numMillsOfSquare++;
+		}
+		EXPECT_GE(numMillsOfSquare, 1);
+	}
+
+	// the three squares of a mill are connected in a row
+	for (bitBoard mill : tables::mills) {
+		EXPECT_EQ(std::popcount(mill), 3);
+		unsigned int numConnections = 0;
+		for (unsigned int pos = 0; pos < tables::size; pos++) {
+			if (mill & (bitBoard{1} << pos)) numConnections += std::popcount(tables::adjacentSquares[pos] & mill);
+		}
+		EXPECT_EQ(numConnections, 4);
+	}
+}
+
+TEST(fieldStruct_Test, test_boardTopology)
+{
+	checkTopology<sixMensMorris>   (8);
+	checkTopology<nineMensMorris>  (16);
+	checkTopology<twelveMensMorris>(20);
+
+	// the diagonals of twelve men's morris
+	EXPECT_EQ(topologyTables<twelveMensMorris>::adjacentSquares[3], topologyTables<nineMensMorris>::adjacentSquares[3] | (bitBoard{1} << 0) | (bitBoard{1} << 6));
+	EXPECT_EQ(topologyTables<sixMensMorris>::adjacentSquares[4], (bitBoard{1} << 1) | (bitBoard{1} << 3) | (bitBoard{1} << 5));
+
+	// the field uses the tables of nine men's morris
+	fieldStruct fs;
+	FIELD field = {	x,    x,    x,
+					  _,  _,  _,
+					    _,_,_,
+				    o,_,_,  _,_,_,
+					    _,_,_,
+					  _,  _,  _,
+				    o,    _,    o};
+	EXPECT_TRUE(setState(fs, field, x, false, 0));
+	EXPECT_EQ(fs.getCurPlayer().numberOfMills, 1);
+	EXPECT_EQ(fs.isStonePartOfMill(1), 1);
+	EXPECT_EQ(fs.isStonePartOfMill(9), 0);
+}
+
+// Helper function playing random games on the board of a topology, checking move, undo, successors and predecessors of each possible move
+template <class topology>
+void checkMoveGeneration()
+{
+	// locals
+	using field = fieldStructOf<topology>;
+	field 								fs;
+	typename field::backupStruct 		oldState;
+	typename field::successorArray		successors;
+	std::vector<unsigned int> 			possibilityIds;
+	std::vector<typename field::packedCore> predFields;
+	unsigned int 						numMovingPhase = 0;
+
+	srand(1);
+	for (unsigned int game = 0; game < 10; game++) {
+		fs.reset(game % 2 ? o : x);
+		for (unsigned int step = 0; step < 100; step++) {
+			fs.getPossibilities(possibilityIds);
+			if (possibilityIds.empty()) break;
+			EXPECT_LE(possibilityIds.size(), static_cast<size_t>(field::maxNumPosMoves));
+			if (!fs.inSettingPhase()) numMovingPhase++;
+
+			// each possible move yields its successor, leads back by undo and has the current state as predecessor
+			const field 					initial = fs;
+			const typename field::packedCore parent{fs};
+			ASSERT_EQ(fs.getSuccessors(successors), possibilityIds.size());
+			for (unsigned int i = 0; i < possibilityIds.size(); i++) {
+				EXPECT_EQ(successors[i].possibilityId, possibilityIds[i]);
+				EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[i]), oldState));
+				EXPECT_TRUE(fs.isIntegrityOk());
+				EXPECT_TRUE(successors[i].state == typename field::packedCore{fs});
+				fs.getPredecessors(predFields);
+				EXPECT_NE(std::find(predFields.begin(), predFields.end(), parent), predFields.end());
+				EXPECT_TRUE(fs.undo(oldState));
+				EXPECT_TRUE(fs == initial);
+				EXPECT_EQ(fs.getHashKey(), initial.getHashKey());
+			}
+			EXPECT_TRUE(fs.move(moveInfo::getMoveInfo(possibilityIds[rand() % possibilityIds.size()]), oldState));
+		}
+	}
+	EXPECT_GT(numMovingPhase, 0);
+}
+
+TEST(fieldStruct_Test, test_moveGenerationOfTopologies)
+{
+	checkMoveGeneration<sixMensMorris>();
+	checkMoveGeneration<nineMensMorris>();
+	checkMoveGeneration<twelveMensMorris>();
+}
+
+TEST(fieldStruct_Test, test_gameRules)
+{
+	// a player with three stones jumps, if the rule set of the field allows it. this test runs for each rule set built in CMakeLists.txt.
+	EXPECT_FALSE(fieldStruct::canJump(2));
+	EXPECT_EQ   (fieldStruct::canJump(3), fieldStruct::rules::jumpingAllowed);
+	EXPECT_FALSE(fieldStruct::canJump(4));
+	EXPECT_FALSE(fieldStruct::movesAlongLines(2));
+	EXPECT_EQ   (fieldStruct::movesAlongLines(3), !fieldStruct::rules::jumpingAllowed);
+	EXPECT_TRUE (fieldStruct::movesAlongLines(4));
+
+	// without jumping a player with three stones is moving along the lines
+	EXPECT_FALSE(noJumpingRules::jumpingAllowed);
+	EXPECT_EQ(noJumpingRules::removeFromMillIfOnlyMills, standardRules::removeFromMillIfOnlyMills);
+
+	// the player 'o' with three stones either jumps to any of the 17 free squares or moves along the lines
+	fieldStruct 				fs;
+	std::vector<unsigned int> 	possibilityIds;
+	FIELD fieldThreeStones = {	_,    o,    _,
+								  o,  o,  _,
+								    _,_,_,
+							    _,_,_,  x,x,x,
+								    x,_,_,
+								  _,  _,  _,
+							    _,    _,    _};
+	EXPECT_TRUE(setState(fs, fieldThreeStones, o, false, 0));
+	fs.getPossibilities(possibilityIds);
+	EXPECT_EQ(possibilityIds.size(), fieldStruct::rules::jumpingAllowed ? 3*17 : 5);
+	for (auto id : possibilityIds) {
+		const moveInfo move = moveInfo::getMoveInfo(id);
+		EXPECT_TRUE(fieldStruct::rules::jumpingAllowed || (fieldStruct::tables::adjacentSquares[move.from] & fieldStruct::squareMask(move.to)));
+	}
+
+	// a stone closing two mills at once cannot be set
+	FIELD field = {	_,    x,    x,
+					  o,  _,  _,
+					    _,_,_,
+				    x,_,_,  o,_,_,
+					    _,_,_,
+					  _,  _,  _,
+				    x,    o,    o};
+	EXPECT_TRUE(setState(fs, field, x, true, 0));
+	fs.getPossibilities(possibilityIds);
+	for (auto id : possibilityIds) {
+		EXPECT_NE(moveInfo::getMoveInfo(id).to, 0);
+	}
+	EXPECT_EQ(possibilityIds.size(), 15);
+}
+
+TEST(fieldStruct_Test, test_validationLevel)
+{
+	fieldStruct 				fs;
+	std::vector<unsigned int> 	possibilityIds;
+	const validationLevel		defaultLevel = fieldStruct::validation;
+
+	// the current player set two stones more than the opponent, which is only detected by the full checks
+	FIELD field = {	x,    _,    _,
+					  _,  x,  _,
+					    _,_,_,
+				    o,_,_,  _,_,x,
+					    _,_,_,
+					  _,  _,  _,
+				    _,    x,    _};
+	EXPECT_FALSE(setState(fs, field, x, true, 0));
+	EXPECT_FALSE(fs.isIntegrityOk());
+	EXPECT_FALSE(fs.isIntegrityOk(validationLevel::full));
+	EXPECT_TRUE (fs.isIntegrityOk(validationLevel::cheap));
+	EXPECT_TRUE (fs.isIntegrityOk(validationLevel::none));
+
+	// the move generator skips the full checks, when the validation level is lowered at run time
+	fieldStruct::validation = validationLevel::full;
+	fs.getPossibilities(possibilityIds);
+	EXPECT_EQ(possibilityIds.size(), 0);
+	fieldStruct::validation = validationLevel::cheap;
+	fs.getPossibilities(possibilityIds);
+	EXPECT_EQ(possibilityIds.size(), 19);
+
+	// a closed mill without any missing stone is already detected by the cheap checks
+	field = {	x,    x,    x,
+				  _,  _,  _,
+				    _,_,_,
+			    o,_,_,  o,_,_,
+				    _,_,_,
+				  _,  _,  _,
+			    _,    _,    o};
+	EXPECT_FALSE(setState(fs, field, x, true, 0));
+	EXPECT_FALSE(fs.isIntegrityOk(validationLevel::cheap));
+	EXPECT_TRUE (fs.isIntegrityOk(validationLevel::none));
+
+	// predecessors are checked fully, so that they do not depend on the validation level
+	EXPECT_EQ(fieldStruct::predecessorValidation, validationLevel::full);
+	std::vector<fieldStruct::packedCore> predsFull, predsNone;
+	field = {	x,    x,    x,
+				  o,  _,  _,
+				    _,_,_,
+			    o,_,_,  _,_,_,
+				    _,_,_,
+				  _,  _,  _,
+			    _,    _,    _};
+	EXPECT_TRUE(setState(fs, field, o, true, 1));
+	fieldStruct::validation = validationLevel::full;
+	fs.getPredecessors(predsFull);
+	fieldStruct::validation = validationLevel::none;
+	fs.getPredecessors(predsNone);
+	EXPECT_FALSE(predsFull.empty());
+	EXPECT_TRUE(predsFull == predsNone);
+
+	fieldStruct::validation = defaultLevel;
+}
+
+TEST(fieldStruct_Test, test_lazyDeducedVariables)
+{
+	// a field, whose deduced variables are calculated on first access
+	fieldStruct lazy;
+	FIELD field = {	x,    x,    x,
+					  o,  _,  _,
+					    _,_,o,
+				    o,_,_,  x,_,_,
+					    _,_,_,
+					  _,  x,  _,
+				    o,    _,    _};
+	EXPECT_TRUE(setState(lazy, field, o, true, 1));
+
+	// the same field, whose deduced variables are read immediately
+	fieldStruct eager = lazy;
+	EXPECT_EQ(eager.getCurPlayer().numPossibleMoves, 15);
+	EXPECT_EQ(eager.getOppPlayer().numberOfMills, 1);
+	EXPECT_EQ(eager.isStonePartOfMill(1), 1);
+
+	// both must behave identically, regardless of the order of access
+	std::vector<fieldStruct::packedCore> predsLazy, predsEager;
+	std::vector<unsigned int> 			 possLazy, possEager;
+	fieldStruct lazyCopy = lazy;
+	lazyCopy.getPredecessors(predsLazy);
+	eager.getPredecessors(predsEager);
+	EXPECT_TRUE(predsLazy == predsEager);
+	lazyCopy = lazy;
+	lazyCopy.getPossibilities(possLazy);
+	eager.getPossibilities(possEager);
+	EXPECT_EQ(possLazy, possEager);
+	lazyCopy = lazy;
+	EXPECT_EQ(lazyCopy.getHashKey(), eager.getHashKey());
+	EXPECT_EQ(lazy, eager);
+}
+
+TEST(fieldStruct_Test, test_separateStoneRemoval)
+{
+	fieldStruct 					fs;
+	fieldStruct::backupStruct		closeMill, removal, combined;
+	std::vector<unsigned int> 		possibilityIds;
+	FIELD field = {	x,    x,    _,
+					  o,  _,  _,
+					    o,_,_,
+				    _,_,_,  o,_,x,
+					    _,_,_,
+					  _,  _,  o,
+				    _,    x,    _};
+	EXPECT_TRUE(setState(fs, field, x, false, 0));
+	const fieldStruct initial = fs;
+
+	// the move closing the mill is generated only once, without any stone removal
+	fs.setStoneRemoval(stoneRemoval::separatePly);
+	fs.getPossibilities(possibilityIds);
+	EXPECT_EQ(std::count(possibilityIds.begin(), possibilityIds.end(), moveInfo{14, 2, 24}.getId()), 1);
+	for (auto id : possibilityIds) {
+		EXPECT_EQ(moveInfo::getMoveInfo(id).removeStone, 24);
+	}
+
+	// after closing the mill the same player removes a stone in a separate ply
+	EXPECT_TRUE(fs.move(moveInfo{14, 2, 24}, closeMill));
+	EXPECT_TRUE(fs.isRemovalPending());
+	EXPECT_EQ(fs.getCurPlayer().id, x);
+	fs.getPossibilities(possibilityIds);
+	std::sort(possibilityIds.begin(), possibilityIds.end());
+	EXPECT_EQ(possibilityIds, (std::vector<unsigned int>{moveInfo{24, 24, 3}.getId(), moveInfo{24, 24, 6}.getId(), moveInfo{24, 24, 12}.getId(), moveInfo{24, 24, 20}.getId()}));
+	EXPECT_FALSE(fs.move(moveInfo{22, 19, 24}, removal));
+
+	// the successors of the pending state are the states after each removal
+	fieldStruct::successorArray successors;
+	ASSERT_EQ(fs.getSuccessors(successors), 4);
+	for (unsigned int i = 0; i < 4; i++) {
+		fieldStruct afterRemoval = fs;
+		EXPECT_TRUE(afterRemoval.move(moveInfo::getMoveInfo(successors[i].possibilityId), removal));
+		EXPECT_TRUE(successors[i].state == fieldStruct::packedCore{afterRemoval});
+	}
+
+	EXPECT_TRUE(fs.move(moveInfo{24, 24, 12}, removal));
+	EXPECT_FALSE(fs.isRemovalPending());
+	EXPECT_EQ(fs.getCurPlayer().id, o);
+
+	// the result is the same as the one of the combined move
+	fieldStruct expected = initial;
+	EXPECT_TRUE(expected.move(moveInfo{14, 2, 12}, combined));
+	EXPECT_EQ(fs, expected);
+	EXPECT_EQ(fs.getHashKey(), expected.getHashKey());
+
+	// both plies are reverted separately
+	EXPECT_TRUE(fs.undo(removal));
+	EXPECT_TRUE(fs.isRemovalPending());
+	EXPECT_EQ(fs.getCurPlayer().id, x);
+	EXPECT_TRUE(fs.undo(closeMill));
+	EXPECT_EQ(fs, initial);
+	EXPECT_EQ(fs.getHashKey(), initial.getHashKey());
+}
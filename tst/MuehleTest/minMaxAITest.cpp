@@ -56,6 +56,36 @@ TEST_F(minMaxAI_Test, simpleFunctions)
 	EXPECT_EQ(move.removeStone, 24);
 }
 
+TEST_F(minMaxAI_Test, separateStoneRemoval) 
+{
+	// locals
+	fieldStruct 				theField;
+	moveInfo 					move;
+	fieldStruct::backupStruct 	oldState;
+
+	myGame.setSearchDepth(4);
+	myGame.setStoneRemoval(stoneRemoval::separatePly);
+
+	// x closes the mill 0-1-2 by moving from 14 to 2
+	theField.reset(x);
+	theField.setSituation({
+		x,    x,    _,
+		  o,  _,  _,
+			o,_,_,
+		_,_,_,  o,_,x,
+			_,_,_,
+		  _,  _,  o,
+		_,    x,    _}, false, 0);
+
+	// the returned move contains the stone removal chosen by the second search
+	myGame.play(theField, move);
+	EXPECT_EQ(move.from, 14);
+	EXPECT_EQ(move.to, 2);
+	EXPECT_THAT(move.removeStone, ::testing::AnyOf(3, 6, 12, 20));
+	EXPECT_TRUE(theField.move(move, oldState));
+	EXPECT_EQ(theField.getCurPlayer().id, o);
+}
+
 TEST_F(minMaxAI_Test, winAgainstRandomAI)
 {
 	// locals
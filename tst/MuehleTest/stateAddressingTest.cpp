@@ -6,6 +6,8 @@
 ***************************************************************************************************************************/
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <atomic>
+#include <set>
 #include "ai/stateAddressing.h"
 
 using groupStateNumber 	= stateAddressing::groupStateNumber;
@@ -133,12 +135,12 @@ TEST_F(StateAddressingTest, internal_variables)
 			for (numBlackStones nbs = 0; nbs < sa.NUM_STONES_PER_PLAYER+1; nbs++) {
 				for (groupIndex index = 0; index < sa.MAX_NUM_SITUATIONS_A * sa.MAX_NUM_SITUATIONS_B; index++) {
 					if (index >= sa.amountSituationsAB[nws][nbs]) break;
-					groupStateNumber stateNumber = sa.groupStateAB[nws][nbs][index];
+					groupStateNumber stateNumber = sa.groupStateAB(nws, nbs, index);
 					EXPECT_EQ(sa.groupIndexAB[stateNumber], index);
 				}
 				for (groupIndex index = 0; index < sa.MAX_NUM_SITUATIONS_C * sa.MAX_NUM_SITUATIONS_D; index++) {
 					if (index >= sa.amountSituationsCD[nws][nbs]) break;
-					groupStateNumber stateNumber = sa.groupStateCD[nws][nbs][index];
+					groupStateNumber stateNumber = sa.groupStateCD(nws, nbs, index);
 					EXPECT_EQ(sa.groupIndexCD[stateNumber], index);
 				}
 			}
@@ -248,7 +250,7 @@ TEST_F(StateAddressingTest, internal_variables)
 					EXPECT_EQ(subLayer.numWhiteStonesGroupCD, nwsCD);
 					EXPECT_EQ(subLayer.numBlackStonesGroupCD, nbsCD);
 				}
-				groupIndex curGroupIndex = 0;
+				stateId curGroupIndex = 0;
 				for (subLayerId subLayerIndex=0; subLayerIndex<layer.numSubLayers; subLayerIndex++) {
 					const auto& subLayer = layer.subLayer[subLayerIndex];
 					EXPECT_EQ(layer.subLayerIndexCD[subLayer.numWhiteStonesGroupCD][subLayer.numBlackStonesGroupCD], subLayerIndex);
@@ -291,6 +293,15 @@ TEST_F(StateAddressingTest, internal_functions)
 		EXPECT_EQ(fieldTmp, fieldTmp2);
 	}
 
+	// check runInParallel(), which must process each chunk exactly once
+	{
+		std::vector<std::atomic<unsigned int>> numCalls(1000);
+		sa.runInParallel(static_cast<unsigned int>(numCalls.size()), [&](unsigned int chunk) { numCalls[chunk]++; });
+		for (const auto& calls : numCalls) {
+			EXPECT_EQ(calls, 1);
+		}
+	}
+
 	// check countStonesInGroup()
 	{
 		numWhiteStones nwsAB, nwsCD;	// x
@@ -333,10 +344,10 @@ TEST_F(StateAddressingTest, test_with_filled_cache_file)
 	// locals
 	stateAddressing sa(tmpFileDirectory);
 	unsigned int 	layerNumber;
-	unsigned int 	stateNumber;
+	stateId 		stateNumber;
 	unsigned int	symOp;
 	fieldStruct		fieldTmp;
-	std::array<unsigned int, stateAddressing::NUM_SYM_OPERATIONS> stateNumbers;
+	std::array<stateId, stateAddressing::NUM_SYM_OPERATIONS> stateNumbers;
 
 	// test if unsigned int is sufficient for stateNumber addressing
 	for (unsigned int curLayer = 0; curLayer < stateAddressing::NUM_LAYERS; curLayer++) {
@@ -381,7 +392,7 @@ TEST_F(StateAddressingTest, test_with_filled_cache_file)
 	EXPECT_EQ(sa.getLayer(layerNumber).amountBlackStones, 7);								// x is player one with black color
 	EXPECT_EQ(sa.getLayer(layerNumber).amountWhiteStones, 7);								// o is player two with white color
 	EXPECT_EQ(sa.getStateNumbersOfSymmetricStates(field, stateNumbers), true);				// Get the state numbers of all symmetric states
-	EXPECT_EQ(stateNumbers, (std::array<unsigned int, stateAddressing::NUM_SYM_OPERATIONS>{	// The state numbers must be the same as the original state number
+	EXPECT_EQ(stateNumbers, (std::array<stateId, stateAddressing::NUM_SYM_OPERATIONS>{	// The state numbers must be the same as the original state number
 		1315916871, 1315916871, 1315916871, 1315916871, 
 		1315916871, 1315916871, 1315916871, 1315916871, 
 		1315916871, 1315916871, 1315916871, 1315916871, 
@@ -400,12 +411,71 @@ TEST_F(StateAddressingTest, test_with_filled_cache_file)
 	EXPECT_EQ(symOp, stateAddressing::SO_INV_LEFT);											// The symmetry operation must be as from above, but rotated by 180 degrees
 }
 
+TEST_F(StateAddressingTest, test_with_corrupted_cache_file)
+{
+	// locals
+	const std::filesystem::path	corruptedDirectory	= std::filesystem::path(tmpFileDirectory).parent_path() / "stateAddressingCorrupted";
+	const std::filesystem::path	corruptedFile		= corruptedDirectory / "preCalculatedVars.dat";
+	stateAddressing::stateId	stateNumber;
+	stateAddressing::symOperationId symOp;
+	std::uintmax_t				fileSize;
+
+	// create a valid cache file and copy it
+	{ stateAddressing sa(tmpFileDirectory); }
+	std::filesystem::remove_all(corruptedDirectory);
+	std::filesystem::create_directories(corruptedDirectory);
+	std::filesystem::copy_file(std::filesystem::path(tmpFileDirectory) / "preCalculatedVars.dat", corruptedFile);
+	fileSize = std::filesystem::file_size(corruptedFile);
+
+	EXPECT_TRUE(field.setSituation({o,    o,    x,
+									  _,  _,  x,
+									    o,_,o,
+									_,_,_,  o,x,x,
+									    _,o,o,
+									  _,  _,  _,
+									x,    x,    x}, true, 3));
+
+	// flip a byte within groupIndexCD, which is not noticed without the checksum
+	{
+		std::fstream file(corruptedFile, std::ios::binary | std::ios::in | std::ios::out);
+		char byte;
+		file.seekg(fileSize / 3);
+		file.read(&byte, 1);
+		byte ^= 0x5A;
+		file.seekp(fileSize / 3);
+		file.write(&byte, 1);
+	}
+	{
+		stateAddressing sa(corruptedDirectory.wstring());
+		EXPECT_EQ(sa.getStateNumber(112, stateNumber, symOp, field), true);
+		EXPECT_EQ(stateNumber, 1315916871);
+	}
+	EXPECT_EQ(std::filesystem::file_size(corruptedFile), fileSize);
+
+	// truncated file
+	std::filesystem::resize_file(corruptedFile, fileSize / 2);
+	{
+		stateAddressing sa(corruptedDirectory.wstring());
+		EXPECT_EQ(sa.getStateNumber(112, stateNumber, symOp, field), true);
+		EXPECT_EQ(stateNumber, 1315916871);
+	}
+	EXPECT_EQ(std::filesystem::file_size(corruptedFile), fileSize);
+
+	// the rewritten file is used again
+	{
+		stateAddressing sa(corruptedDirectory.wstring());
+		EXPECT_EQ(sa.getStateNumber(112, stateNumber, symOp, field), true);
+		EXPECT_EQ(stateNumber, 1315916871);
+	}
+	std::filesystem::remove_all(corruptedDirectory);
+}
+
 TEST_F(StateAddressingTest, test_getStateNumber_setField_consistency)
 {
 	// locals
 	stateAddressing sa(tmpFileDirectory);
 	unsigned int 	layerNumber;
-	unsigned int 	stateNumber, stateNumber2;
+	stateId 		stateNumber, stateNumber2;
 	unsigned int	symOp2;
 	fieldStruct		fieldTmp;
 	playerId 		curPlayer, oppPlayer;
@@ -434,11 +504,184 @@ TEST_F(StateAddressingTest, test_getStateNumber_setField_consistency)
 				EXPECT_EQ(stateNumber, 	stateNumber2);
 				EXPECT_EQ(symOp2, 		stateAddressing::SO_DO_NOTHING);
 				EXPECT_EQ(curPlayer, 	fieldTmp.getCurPlayer().id);
+
+				// the packed field must lead to the same state number
+				stateNumber2 	= 0xdeadbeef;
+				EXPECT_EQ(sa.getLayerNumber(fieldStruct::packedCore{fieldTmp}), layerNumber);
+				EXPECT_TRUE(sa.getStateNumber(layerNumber, stateNumber2, symOp2, fieldStruct::packedCore{fieldTmp}));
+				EXPECT_EQ(stateNumber, 	stateNumber2);
+				EXPECT_EQ(symOp2, 		stateAddressing::SO_DO_NOTHING);
 			}
 		}
 	}
 }
 
+TEST_F(StateAddressingTest, test_getStateNumbers_batch)
+{
+	// locals
+	stateAddressing 								sa(tmpFileDirectory);
+	fieldStruct::backupStruct 						oldState;
+	std::vector<unsigned int> 						possibilityIds;
+	std::vector<fieldStruct::packedCore> 			predFields;
+	std::vector<fieldStruct::packedCore> 			states;
+	std::vector<stateAddressing::stateNumberStruct>	results;
+	stateId											stateNumber;
+	symOperationId									symOp;
+
+	// states of random games and their predecessors
+	srand(1);
+	for (unsigned int game = 0; game < 10; game++) {
+		field.reset(game % 2 ? o : x);
+		for (unsigned int step = 0; step < 60; step++) {
+			states.push_back(fieldStruct::packedCore{field});
+			field.getPredecessors(predFields);
+			states.insert(states.end(), predFields.begin(), predFields.end());
+			field.getPossibilities(possibilityIds);
+			if (possibilityIds.empty() || field.hasGameFinished()) break;
+			EXPECT_TRUE(field.move(moveInfo::getMoveInfo(possibilityIds[rand() % possibilityIds.size()]), oldState));
+		}
+	}
+	states.push_back(states.front());
+	ASSERT_NE(states.size() % stateAddressing::stateNumberBatchSize, 0);
+
+	// the batch must match the single calls
+	EXPECT_TRUE(sa.getStateNumbers(states, results));
+	ASSERT_EQ(results.size(), states.size());
+	for (size_t i = 0; i < states.size(); i++) {
+		EXPECT_EQ(results[i].layerNum, sa.getLayerNumber(states[i]));
+		EXPECT_TRUE(sa.getStateNumber(results[i].layerNum, stateNumber, symOp, states[i]));
+		EXPECT_EQ(results[i].stateNumber, stateNumber);
+		EXPECT_EQ(results[i].symOp, symOp);
+	}
+}
+
+TEST_F(StateAddressingTest, test_layerIterator)
+{
+	// locals
+	stateAddressing sa(tmpFileDirectory);
+	fieldStruct		fieldTmp;
+	unsigned int	numStates;
+
+	// whole layers of the moving and of the setting phase, and a range crossing sublayers
+	const std::vector<std::array<stateId, 3>> ranges = {
+		{ 3, 0, std::numeric_limits<stateId>::max()},
+		{24, 0, std::numeric_limits<stateId>::max()},
+		{ sa.getLayerNumber(3, 2, true), 0, std::numeric_limits<stateId>::max()},
+		{112, 1315916000, 1315918000},
+		{112, 400000000, 400050000},
+	};
+
+	for (const auto& [layerNum, firstState, endState] : ranges) {
+		for (playerId curPlayer : {x, o}) {
+			numStates = 0;
+			for (stateAddressing::layerIterator it(sa, layerNum, curPlayer, firstState, endState); !it.isEnd(); it.next()) {
+				EXPECT_EQ(it.getStateNumber(), firstState + numStates);
+				fieldTmp.reset(curPlayer == x ? o : x);
+				EXPECT_EQ(it.isValid(), sa.getFieldByStateNumber(layerNum, it.getStateNumber(), fieldTmp, curPlayer));
+				if (it.isValid()) {
+					EXPECT_EQ(fieldStruct::packedCore{it.getField()}, fieldStruct::packedCore{fieldTmp});
+					EXPECT_EQ(it.getField(), fieldTmp);
+				}
+				numStates++;
+			}
+			EXPECT_EQ(numStates, (endState < sa.getNumberOfKnotsInLayer(layerNum) ? endState : sa.getNumberOfKnotsInLayer(layerNum)) - firstState);
+		}
+	}
+}
+
+TEST_F(StateAddressingTest, test_getUniqueSymmetricStates)
+{
+	// locals
+	stateAddressing sa(tmpFileDirectory);
+	fieldStruct		fieldTmp;
+	fieldStruct		symField;
+	stateId			stateNumber;
+	symOperationId	symOp;
+	std::array<stateId, stateAddressing::NUM_SYM_OPERATIONS>								stateNumbers;
+	std::array<stateAddressing::stateNumberStruct, stateAddressing::NUM_SYM_OPERATIONS>	symStates;
+
+	// the states of all symmetric fields, each one calculated separately
+	for (const auto& [layerNum, firstState, endState] : std::vector<std::array<stateId, 3>>{{3, 0, 2000}, {24, 0, 2000}, {112, 1315916000, 1315918000}}) {
+		for (stateAddressing::layerIterator it(sa, layerNum, o, firstState, endState); !it.isEnd(); it.next()) {
+			if (!it.isValid()) continue;
+			std::set<stateId> expected;
+			for (symOperationId op = 0; op < stateAddressing::NUM_SYM_OPERATIONS; op++) {
+				symField = it.getField();
+				EXPECT_TRUE(sa.applySymmetryTransfToField(op, false, symField));
+				EXPECT_TRUE(sa.getStateNumber(layerNum, stateNumber, symOp, symField));
+				expected.insert(stateNumber);
+			}
+
+			// each state once, starting with the state of the field itself
+			const unsigned int numStates = sa.getUniqueSymmetricStates(fieldStruct::packedCore{it.getField()}, symStates);
+			ASSERT_EQ(numStates, expected.size());
+			EXPECT_EQ(symStates[0].stateNumber, it.getStateNumber());
+			EXPECT_TRUE(sa.getStateNumbersOfSymmetricStates(it.getField(), stateNumbers));
+			EXPECT_EQ(std::set<stateId>(stateNumbers.begin(), stateNumbers.end()), expected);
+			for (unsigned int i = 0; i < numStates; i++) {
+				EXPECT_EQ(symStates[i].layerNum, layerNum);
+				EXPECT_TRUE(expected.count(symStates[i].stateNumber));
+				EXPECT_TRUE(sa.getFieldByStateNumber(layerNum, symStates[i].stateNumber, fieldTmp, o));
+				EXPECT_TRUE(sa.applySymmetryTransfToField(symStates[i].symOp, true, fieldTmp));
+				EXPECT_EQ(fieldTmp, it.getField());
+			}
+		}
+	}
+}
+
+TEST_F(StateAddressingTest, test_tableFree_rankingEngine)
+{
+	// locals
+	stateAddressing sa(tmpFileDirectory);
+	stateAddressing saTableFree(tmpFileDirectory, stateAddressing::rankingEngine::tableFree);
+	fieldStruct		fieldTmp;
+	stateId			stateNumber, stateNumberTableFree;
+	symOperationId	symOp, symOpTableFree;
+	groupIndex		indexCD;
+	std::vector<fieldStruct::packedCore>				states;
+	std::vector<stateAddressing::stateNumberStruct>		results, resultsTableFree;
+
+	// neither the large tables nor the file are kept
+	EXPECT_EQ(sa.getRankingEngine(), stateAddressing::rankingEngine::lookupTables);
+	EXPECT_EQ(saTableFree.getRankingEngine(), stateAddressing::rankingEngine::tableFree);
+	EXPECT_EQ(saTableFree.groupIndexCD.size(), 0);
+	EXPECT_EQ(saTableFree.symmetryOperationCD.size(), 0);
+	EXPECT_EQ(saTableFree.cacheMapping.data(), nullptr);
+
+	// each state of group C&D
+	for (groupStateNumber stateCD = 0; stateCD < sa.MAX_NUM_SITUATIONS_C * sa.MAX_NUM_SITUATIONS_D; stateCD++) {
+		const bitBoard whiteStones = sa.bitBoardsOfLowDigitsCD[stateCD % sa.MAX_NUM_SITUATIONS_D].white | sa.bitBoardsOfHighDigitsCD[stateCD / sa.MAX_NUM_SITUATIONS_D].white;
+		const bitBoard blackStones = sa.bitBoardsOfLowDigitsCD[stateCD % sa.MAX_NUM_SITUATIONS_D].black | sa.bitBoardsOfHighDigitsCD[stateCD / sa.MAX_NUM_SITUATIONS_D].black;
+		if (std::popcount(whiteStones) > sa.NUM_STONES_PER_PLAYER || std::popcount(blackStones) > sa.NUM_STONES_PER_PLAYER) continue;
+		saTableFree.findOriginalStateCD(whiteStones, blackStones, std::popcount(whiteStones), std::popcount(blackStones), indexCD, symOp);
+		ASSERT_EQ(indexCD, sa.groupIndexCD[stateCD]);
+		ASSERT_EQ(symOp, sa.symmetryOperationCD[stateCD]);
+	}
+
+	// same state numbers and fields as with the tables
+	for (const auto& [layerNum, firstState, endState] : std::vector<std::array<stateId, 3>>{{3, 0, 5000}, {24, 0, 5000}, {112, 1315916000, 1315921000}}) {
+		states.clear();
+		for (stateAddressing::layerIterator it(saTableFree, layerNum, x, firstState, endState); !it.isEnd(); it.next()) {
+			EXPECT_EQ(it.isValid(), saTableFree.getFieldByStateNumber(layerNum, it.getStateNumber(), fieldTmp, x));
+			if (!it.isValid()) continue;
+			EXPECT_EQ(fieldTmp, it.getField());
+			EXPECT_TRUE(sa.getStateNumber(layerNum, stateNumber, symOp, it.getField()));
+			EXPECT_TRUE(saTableFree.getStateNumber(layerNum, stateNumberTableFree, symOpTableFree, it.getField()));
+			EXPECT_EQ(stateNumberTableFree, stateNumber);
+			EXPECT_EQ(symOpTableFree, symOp);
+			EXPECT_EQ(stateNumber, it.getStateNumber());
+			states.push_back(fieldStruct::packedCore{it.getField()});
+		}
+		EXPECT_TRUE(sa.getStateNumbers(states, results));
+		EXPECT_TRUE(saTableFree.getStateNumbers(states, resultsTableFree));
+		for (size_t i = 0; i < states.size(); i++) {
+			EXPECT_EQ(resultsTableFree[i].layerNum,		results[i].layerNum);
+			EXPECT_EQ(resultsTableFree[i].stateNumber,	results[i].stateNumber);
+			EXPECT_EQ(resultsTableFree[i].symOp,		results[i].symOp);
+		}
+	}
+}
+
 TEST_F(StateAddressingTest, totalNumMissingStones)
 {
 	// locals
@@ -477,4 +720,20 @@ TEST_F(StateAddressingTest, totalNumMissingStones)
 		stateAddressing::layerId 		layerNumMovingPhase 	= sa.getLayerNumber(nws, nbs, false);
 		EXPECT_EQ(sa.getNumberOfKnotsInLayer(layerNumSettingPhase), sa.getNumberOfKnotsInLayer(layerNumMovingPhase) * sa.getMaxTotalNumMissingStones(nws,nbs));
 	}
+
+	// the number of knots must not wrap around in any layer
+	for (stateAddressing::layerId layerNum = 0; layerNum < stateAddressing::NUM_LAYERS; layerNum++) {
+		const auto& 	layer 			= sa.layer[layerNum];
+		std::uint64_t	numKnots		= 0;
+		for (stateAddressing::subLayerId subLayerIndex = 0; subLayerIndex < layer.numSubLayers; subLayerIndex++) {
+			const auto& subLayer = layer.subLayer[subLayerIndex];
+			numKnots += static_cast<std::uint64_t>(sa.amountSituationsAB[subLayer.numWhiteStonesGroupAB][subLayer.numBlackStonesGroupAB]) * sa.amountSituationsCD[subLayer.numWhiteStonesGroupCD][subLayer.numBlackStonesGroupCD];
+		}
+		if (sa.isSettingPhase(layerNum)) numKnots *= sa.getMaxTotalNumMissingStones(layer.amountWhiteStones, layer.amountBlackStones);
+		if (sa.getNumberOfKnotsInLayer(layerNum)) EXPECT_EQ(sa.getNumberOfKnotsInLayer(layerNum), numKnots);
+		EXPECT_LT(numKnots, stateAddressing::INVALID_STATE_NUMBER);
+	}
+
+	// the state number of an unaddressed state is not the one of any state, regardless of the width of stateId
+	EXPECT_EQ(stateAddressing::stateNumberStruct{}.stateNumber, std::numeric_limits<stateId>::max());
 }
\ No newline at end of file
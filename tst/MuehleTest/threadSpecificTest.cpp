@@ -16,7 +16,8 @@ protected:
 	static const std::wstring tmpFileDirectory;
 
 	stateAddressing								sa{tmpFileDirectory};
-	unsigned int 								layerNum, stateNumber, symOp;
+	unsigned int 								layerNum, symOp;
+	stateAddressing::stateId					stateNumber;
 	vector<unsigned int> 						possibilityIds;
 	vector<miniMax::stateAdressStruct> 			symStates;
 	vector<miniMax::retroAnalysis::predVars> 	predVars;
@@ -142,3 +143,23 @@ TEST_F(threadVarsStruct_Test, setSituation)
 	EXPECT_EQ(stateNumber, 0);
 	EXPECT_EQ(symOp, stateAddressing::SO_DO_NOTHING);
 }
+
+TEST_F(threadVarsStruct_Test, toMiniMaxStateNumber)
+{
+	// locals
+	unsigned int miniMaxStateNumber = 0;
+
+	// state numbers within 32 bit are passed unchanged to the miniMax library
+	EXPECT_TRUE(threadVarsStruct::toMiniMaxStateNumber(0, miniMaxStateNumber));
+	EXPECT_EQ(miniMaxStateNumber, 0);
+	EXPECT_TRUE(threadVarsStruct::toMiniMaxStateNumber(6172, miniMaxStateNumber));
+	EXPECT_EQ(miniMaxStateNumber, 6172);
+	EXPECT_TRUE(threadVarsStruct::toMiniMaxStateNumber(std::numeric_limits<unsigned int>::max(), miniMaxStateNumber));
+	EXPECT_EQ(miniMaxStateNumber, std::numeric_limits<unsigned int>::max());
+
+	// larger ones must not be truncated
+	if constexpr (sizeof(stateAddressing::stateId) > sizeof(unsigned int)) {
+		EXPECT_FALSE(threadVarsStruct::toMiniMaxStateNumber(stateAddressing::stateId{std::numeric_limits<unsigned int>::max()} + 1, miniMaxStateNumber));
+		EXPECT_EQ(miniMaxStateNumber, std::numeric_limits<unsigned int>::max());
+	}
+}